@@ -123,16 +123,27 @@ int main(int argc, char *argv[]) {
   cout << "# prediction took " << timer.elapsed() << endl;
 
   // compute accuracy score of prediction
-  size_t incorrect_quant = 0;
-  for (size_t i=0; i<m; i++)
-    if ((prediction[i] >= 0 && test_labels[i] < 0) ||
-        (prediction[i] < 0 && test_labels[i] >= 0))
-      incorrect_quant++;
-  cout << "# prediction score: "
-       << (float(m - incorrect_quant) / m) * 100. << "%" << endl
-       << "# c-err: "
-       << (float(incorrect_quant) / m) * 100. << "%"
-       << endl << endl;
+  auto score = [&](const vector<scalar_t>& prediction) {
+    size_t incorrect_quant = 0;
+    for (size_t i=0; i<m; i++)
+      if ((prediction[i] >= 0 && test_labels[i] < 0) ||
+          (prediction[i] < 0 && test_labels[i] >= 0))
+        incorrect_quant++;
+    cout << "# prediction score: "
+         << (float(m - incorrect_quant) / m) * 100. << "%" << endl
+         << "# c-err: "
+         << (float(incorrect_quant) / m) * 100. << "%"
+         << endl << endl;
+  };
+  score(prediction);
+
+  // approximate prediction, using the cluster tree of the training
+  // data and low-rank approximations
+  cout << "# treecode prediction start..." << endl;
+  timer.start();
+  auto prediction_tc = K->predict_treecode(test_points, weights, 1e-4);
+  cout << "# treecode prediction took " << timer.elapsed() << endl;
+  score(prediction_tc);
 
   return 0;
 }
@@ -165,6 +165,13 @@ namespace strumpack {
        const std::vector<std::size_t>& tiles2,
        const adm_t& admissible, const BLROptions<T>& opts);
 
+      template<typename T> friend void
+      BLR_Schur_complement
+      (std::size_t n2, const extract_t<T>& A22,
+       const BLRMatrix<T>& B21, const BLRMatrix<T>& B12,
+       BLRMatrix<T>& B22, const std::vector<std::size_t>& tiles2,
+       const BLROptions<T>& opts);
+
       template<typename T> friend void
       BLR_trsmLNU_gemm
       (const BLRMatrix<T>& F1, const BLRMatrix<T>& F2,
@@ -613,6 +620,9 @@ namespace strumpack {
       piv.resize(B11.rows());
       auto rb = B11.rowblocks();
       auto rb2 = B21.rowblocks();
+      // if A22 is empty, the Schur complement is not computed here,
+      // see BLR_Schur_complement
+      auto rbS = A22.rows() ? rb2 : 0;
 #if defined(STRUMPACK_USE_OPENMP_TASK_DEPEND)
       auto lrb = rb+rb2;
       // dummy for task synchronization
@@ -723,8 +733,8 @@ namespace strumpack {
               }
             }
 
-          for (std::size_t j=0; j<rb2; j++)
-            for (std::size_t k=0; k<rb2; k++) {
+          for (std::size_t j=0; j<rbS; j++)
+            for (std::size_t k=0; k<rbS; k++) {
 #if defined(STRUMPACK_USE_OPENMP_TASK_DEPEND)
               std::size_t ij2 = i+lrb*(rb+j), k2i = (rb+k)+lrb*i, k2j2 = (rb+k)+lrb*(rb+j);
 #pragma omp task default(shared) firstprivate(i,j,k,ij2,k2i,k2j2)       \
@@ -814,6 +824,41 @@ namespace strumpack {
           piv[l] += B11.tileroff(i);
     }
 
+    /**
+     * Compute the Schur complement B22 = A22 - B21 B12 directly in
+     * BLR form. A22 is only accessed through the element extraction
+     * routine, so the full dense matrix is never formed. Each tile
+     * receives all its (low-rank) updates in a dense leaf sized
+     * buffer, after which the off-diagonal tiles are recompressed.
+     */
+    template<typename scalar_t> void
+    BLR_Schur_complement
+    (std::size_t n2, const extract_t<scalar_t>& A22,
+     const BLRMatrix<scalar_t>& B21, const BLRMatrix<scalar_t>& B12,
+     BLRMatrix<scalar_t>& B22, const std::vector<std::size_t>& tiles2,
+     const BLROptions<scalar_t>& opts) {
+      B22 = BLRMatrix<scalar_t>(n2, tiles2, n2, tiles2);
+      auto rb = B21.colblocks();
+      auto rb2 = B22.rowblocks();
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop collapse(2) default(shared)
+#endif
+      for (std::size_t j=0; j<rb2; j++)
+        for (std::size_t i=0; i<rb2; i++) {
+          B22.create_dense_tile(i, j, A22);
+          auto& D = B22.tile(i, j).D();
+          for (std::size_t k=0; k<rb; k++)
+            gemm(Trans::N, Trans::N, scalar_t(-1.), B21.tile(i, k),
+                 B12.tile(k, j), scalar_t(1.), D);
+          if (i != j) {
+            std::unique_ptr<LRTile<scalar_t>> T
+              (new LRTile<scalar_t>(D, opts));
+            if (T->rank()*(D.rows() + D.cols()) < D.rows()*D.cols())
+              B22.block(i, j) = std::move(T);
+          }
+        }
+    }
+
 
     template<typename scalar_t> void BLR_trsmLNU_gemm
     (const BLRMatrix<scalar_t>& F1, const BLRMatrix<scalar_t>& F2,
@@ -86,6 +86,7 @@ namespace strumpack {
       LowRankAlgorithm lr_algo_ = LowRankAlgorithm::RRQR;
       int BACA_blocksize_ = 4;
       Admissibility adm_ = Admissibility::STRONG;
+      bool compress_CB_ = false;
 
     public:
       /*! \brief For Pieter to complete
@@ -119,6 +120,12 @@ namespace strumpack {
         assert(B > 0);
         BACA_blocksize_ = B;
       }
+      /**
+       * Keep the contribution block (Schur complement) of the BLR
+       * fronts in compressed BLR form, instead of as a dense
+       * matrix. This reduces the peak memory of the factorization.
+       */
+      void set_compress_CB(bool b) { compress_CB_ = b; }
 
       real_t rel_tol() const { return rel_tol_; }
       real_t abs_tol() const { return abs_tol_; }
@@ -128,6 +135,7 @@ namespace strumpack {
       Admissibility admissibility() const { return adm_; }
       bool verbose() const { return verbose_; }
       int BACA_blocksize() const { return BACA_blocksize_; }
+      bool compress_CB() const { return compress_CB_; }
 
       void set_from_command_line(int argc, const char* const* argv) {
         std::vector<char*> argv_local(argc);
@@ -143,6 +151,8 @@ namespace strumpack {
           {"blr_low_rank_algorithm",    required_argument, 0, 5},
           {"blr_admissibility",         required_argument, 0, 6},
           {"blr_BACA_blocksize",        required_argument, 0, 7},
+          {"blr_compress_cb",           no_argument, 0, 8},
+          {"blr_dense_cb",              no_argument, 0, 9},
           {"blr_verbose",               no_argument, 0, 'v'},
           {"blr_quiet",                 no_argument, 0, 'q'},
           {"help",                      no_argument, 0, 'h'},
@@ -203,6 +213,8 @@ namespace strumpack {
             iss >> BACA_blocksize_;
             set_BACA_blocksize(BACA_blocksize_);
           } break;
+          case 8: set_compress_CB(true); break;
+          case 9: set_compress_CB(false); break;
 
           case 'v': set_verbose(true); break;
           case 'q': set_verbose(false); break;
@@ -234,6 +246,12 @@ namespace strumpack {
                   << "#      should be one of [weak|strong]" << std::endl
                   << "#   --blr_BACA_blocksize int (default "
                   << BACA_blocksize() << ")" << std::endl
+                  << "#   --blr_compress_cb (default "
+                  << compress_CB() << ")" << std::endl
+                  << "#      keep the contribution blocks in BLR form"
+                  << std::endl
+                  << "#   --blr_dense_cb (default "
+                  << !compress_CB() << ")" << std::endl
                   << "#   --blr_verbose or -v (default "
                   << verbose() << ")" << std::endl
                   << "#   --blr_quiet or -q (default "
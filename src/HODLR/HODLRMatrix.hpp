@@ -580,6 +580,7 @@ namespace strumpack {
       rows_ = cols_ = K.n();
       auto tree = binary_tree_clustering
         (opts.clustering_algorithm(), K.data(), K.permutation(), opts.leaf_size());
+      K.tree() = tree;
       int min_lvl = 2 + std::ceil(std::log2(c.size()));
       lvls_ = std::max(min_lvl, tree.levels());
       tree.expand_complete_levels(lvls_);
@@ -689,6 +689,7 @@ namespace strumpack {
       auto t = binary_tree_clustering
         (opts.clustering_algorithm(), K.data(), K.permutation(), opts.leaf_size());
       K.permute();
+      K.tree() = t;
       if (opts.verbose())
         std::cout << "# clustering (" << get_name(opts.clustering_algorithm())
                   << ") time = " << timer.elapsed() << std::endl;
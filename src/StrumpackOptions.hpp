@@ -198,6 +198,30 @@ namespace strumpack {
   }
 
 
+  /**
+   * Enumeration of factorization types for the dense frontal
+   * matrices.
+   * \ingroup Enumerations
+   */
+  enum class FactorizationType {
+    LU,       /*!< LU with partial pivoting, for general matrices     */
+    CHOLESKY  /*!< Cholesky, for symmetric (Hermitian) positive
+                definite matrices. Only the lower triangular part of
+                the fronts is factored and stored. Disables
+                matching, which destroys symmetry.                   */
+  };
+
+  /**
+   * Return a name/string for the FactorizationType.
+   */
+  inline std::string get_name(FactorizationType f) {
+    switch (f) {
+    case FactorizationType::LU: return "lu";
+    case FactorizationType::CHOLESKY: return "cholesky";
+    }
+    return "UNKNOWN";
+  }
+
   /**
    * Type of Gram-Schmidt orthogonalization used in GMRes.
    * \ingroup Enumerations
@@ -246,6 +270,8 @@ namespace strumpack {
 
   inline int default_cuda_cutoff() { return 500; }
   inline int default_cuda_streams() { return 10; }
+  inline int default_batch_cutoff() { return 64; }
+  inline int default_tiled_LU_cutoff() { return 2048; }
 
   /**
    * \class SPOptions
@@ -512,6 +538,25 @@ namespace strumpack {
      */
     void disable_METIS_NodeND() { _use_METIS_NodeNDP = true; }
 
+    /**
+     * Compute the top levels of the METIS nested dissection with
+     * multiple threads: the graph is split with a METIS vertex
+     * separator and both halves are ordered recursively, in separate
+     * OpenMP tasks. This is only used with METIS_NodeND, and when
+     * running with more than one thread. This is enabled by default.
+     *
+     * \see disable_parallel_ND(), enable_METIS_NodeND()
+     */
+    void enable_parallel_ND() { parallel_ND_ = true; }
+
+    /**
+     * Compute the METIS nested dissection with a single call to
+     * METIS_NodeND.
+     *
+     * \see enable_parallel_ND()
+     */
+    void disable_parallel_ND() { parallel_ND_ = false; }
+
     /**
      * Use the SYMQAMD routine (provided by the MUMPS folks) to
      * construct the supernodal tree from the elimination tree. In
@@ -562,6 +607,38 @@ namespace strumpack {
      */
     void set_matching(MatchingJob job) { _matching_job = job; }
 
+    /**
+     * Set the factorization type for the (dense) frontal
+     * matrices. FactorizationType::CHOLESKY can only be used for
+     * symmetric (Hermitian) positive definite matrices. It requires
+     * about half the flops and half the memory of the LU
+     * factorization. Since matching destroys symmetry, matching
+     * will not be performed (see set_matching()).
+     *
+     * \param f factorization type
+     */
+    void set_factorization(FactorizationType f) { _factorization = f; }
+
+    /**
+     * Enable mixed precision. The multifrontal factorization is then
+     * computed in single precision (float or std::complex<float>),
+     * and used as a preconditioner for the outer iterative solver
+     * (iterative refinement, GMRES, BiCGStab), which runs in the
+     * working precision. This halves the memory for the factors. It
+     * only has effect in the sequential/multithreaded solver, for
+     * double or std::complex<double>, and without compression.
+     *
+     * \see disable_mixed_precision()
+     */
+    void enable_mixed_precision() { _mixed_precision = true; }
+
+    /**
+     * Disable mixed precision, factor in the working precision.
+     *
+     * \see enable_mixed_precision()
+     */
+    void disable_mixed_precision() { _mixed_precision = false; }
+
     /**
      * Log the assembly tree to a file. __Currently not supported.__
      */
@@ -709,6 +786,59 @@ namespace strumpack {
      */
     void set_cuda_streams(int s) { cuda_streams_ = s; }
 
+    /**
+     * Set the front size below which subtrees of dense fronts are
+     * factored level by level, with all small fronts of a level in
+     * one parallel loop, instead of with one OpenMP task per
+     * front. Set to 0 to disable.
+     */
+    void set_batch_cutoff(int c) { assert(c >= 0); batch_cutoff_ = c; }
+
+    /**
+     * Set the separator size from which dense fronts are factored
+     * with a tiled LU factorization, with OpenMP task dependencies
+     * between the tile operations, instead of a single getrf
+     * followed by trsm and gemm. Set to 0 to disable.
+     */
+    void set_tiled_LU_cutoff(int c) { assert(c >= 0); tiled_LU_cutoff_ = c; }
+
+    /**
+     * Store the contribution blocks of the dense fronts in a
+     * sequential subtree on a stack, preallocated for the entire
+     * subtree, instead of allocating memory for every front. This is
+     * enabled by default.
+     *
+     * \see disable_CB_workspace()
+     */
+    void enable_CB_workspace() { CB_workspace_ = true; }
+
+    /**
+     * Allocate the contribution block of every dense front
+     * separately.
+     *
+     * \see enable_CB_workspace()
+     */
+    void disable_CB_workspace() { CB_workspace_ = false; }
+
+    /**
+     * Factor the top of the elimination tree as a task graph: every
+     * child front extend-adds into its parent as soon as it is done,
+     * and the dense factorization of the fronts near the root uses
+     * OpenMP tasks instead of the threaded system BLAS. This is
+     * disabled by default.
+     *
+     * \see disable_task_DAG()
+     */
+    void enable_task_DAG() { task_DAG_ = true; }
+
+    /**
+     * Use the fork-join factorization of the elimination tree, with
+     * the threaded system BLAS for the fronts near the root.
+     *
+     * \see enable_task_DAG()
+     */
+    void disable_task_DAG() { task_DAG_ = false; }
+
     /**
      * Set the precision for lossy compression.
      */
@@ -720,6 +850,22 @@ namespace strumpack {
      */
     void set_print_root_front_stats(bool b)  { _print_root_front_stats = b; }
 
+    /**
+     * Record the assembly and factorization of every dense front
+     * during the numerical factorization, and write the timeline to
+     * this file, in the Chrome trace event format. With multiple MPI
+     * processes, every rank writes its own file, see
+     * TraceLog::write(). An empty filename, the default, disables
+     * the trace.
+     */
+    void set_trace_file(const std::string& f) { trace_file_ = f; }
+
+    /**
+     * Check if mixed precision is enabled.
+     * \see enable_mixed_precision()
+     */
+    bool use_mixed_precision() const { return _mixed_precision; }
+
     /**
      * Check if verbose output is enabled.
      * \see set_verbose()
@@ -817,6 +963,12 @@ namespace strumpack {
      */
     bool use_METIS_NodeND() const { return !_use_METIS_NodeNDP; }
 
+    /**
+     * Is the multithreaded METIS nested dissection enabled?
+     * \see enable_parallel_ND()
+     */
+    bool use_parallel_ND() const { return parallel_ND_; }
+
     /**
      * Is MUMPS_SYMQAMD enabled?
      * \see enable_MUMPS_SYMQAMD()
@@ -836,6 +988,12 @@ namespace strumpack {
      */
     MatchingJob matching() const { return _matching_job; }
 
+    /**
+     * Get the factorization type for the frontal matrices.
+     * \see set_factorization()
+     */
+    FactorizationType factorization() const { return _factorization; }
+
     /**
      * Should we log the assembly tree?
      * __Currently not supported.__
@@ -937,6 +1095,34 @@ namespace strumpack {
      */
     int cuda_cutoff() const { return cuda_cutoff_; }
 
+    /**
+     * Returns the front size below which subtrees of dense fronts
+     * are factored level by level.
+     * \see set_batch_cutoff()
+     */
+    int batch_cutoff() const { return batch_cutoff_; }
+
+    /**
+     * Returns the separator size from which dense fronts are factored
+     * with the tiled LU factorization, 0 if disabled.
+     * \see set_tiled_LU_cutoff()
+     */
+    int tiled_LU_cutoff() const { return tiled_LU_cutoff_; }
+
+    /**
+     * Check whether the contribution blocks of the dense fronts are
+     * stored on a preallocated stack.
+     * \see enable_CB_workspace()
+     */
+    bool use_CB_workspace() const { return CB_workspace_; }
+
+    /**
+     * Check whether the top of the elimination tree is factored as a
+     * task graph.
+     * \see enable_task_DAG()
+     */
+    bool use_task_DAG() const { return task_DAG_; }
+
     /**
      * Returns the number of CUDA streams to use.
      */
@@ -953,6 +1139,13 @@ namespace strumpack {
      */
     bool print_root_front_stats() const { return _print_root_front_stats; }
 
+    /**
+     * Filename for the trace of the numerical factorization, empty
+     * if disabled.
+     * \see set_trace_file()
+     */
+    const std::string& trace_file() const { return trace_file_; }
+
     /**
      * Get a (const) reference to an object holding various options
      * pertaining to the HSS code, and data structures.
@@ -1057,6 +1250,18 @@ namespace strumpack {
         {"sp_cuda_cutoff",               required_argument, 0, 38},
         {"sp_cuda_streams",              required_argument, 0, 39},
         {"sp_lossy_precision",           required_argument, 0, 40},
+        {"sp_factorization",             required_argument, 0, 41},
+        {"sp_enable_mixed_precision",    no_argument, 0, 42},
+        {"sp_disable_mixed_precision",   no_argument, 0, 43},
+        {"sp_batch_cutoff",              required_argument, 0, 44},
+        {"sp_enable_CB_workspace",       no_argument, 0, 45},
+        {"sp_disable_CB_workspace",      no_argument, 0, 46},
+        {"sp_enable_parallel_ND",        no_argument, 0, 47},
+        {"sp_disable_parallel_ND",       no_argument, 0, 48},
+        {"sp_trace_file",                required_argument, 0, 49},
+        {"sp_enable_task_DAG",           no_argument, 0, 50},
+        {"sp_disable_task_DAG",          no_argument, 0, 51},
+        {"sp_tiled_LU_cutoff",           required_argument, 0, 52},
         {"sp_verbose",                   no_argument, 0, 'v'},
         {"sp_quiet",                     no_argument, 0, 'q'},
         {"help",                         no_argument, 0, 'h'},
@@ -1226,6 +1431,34 @@ namespace strumpack {
           iss >> _lossy_precision;
           set_lossy_precision(_lossy_precision);
         } break;
+        case 41: {
+          std::string s; std::istringstream iss(optarg); iss >> s;
+          for (auto& c : s) c = std::toupper(c);
+          if (s == "LU") set_factorization(FactorizationType::LU);
+          else if (s == "CHOLESKY")
+            set_factorization(FactorizationType::CHOLESKY);
+          else std::cerr << "# WARNING: factorization type not"
+                 " recognized, use 'lu' or 'cholesky'" << std::endl;
+        } break;
+        case 42: { enable_mixed_precision(); } break;
+        case 43: { disable_mixed_precision(); } break;
+        case 44: {
+          std::istringstream iss(optarg);
+          iss >> batch_cutoff_;
+          set_batch_cutoff(batch_cutoff_);
+        } break;
+        case 45: { enable_CB_workspace(); } break;
+        case 46: { disable_CB_workspace(); } break;
+        case 47: { enable_parallel_ND(); } break;
+        case 48: { disable_parallel_ND(); } break;
+        case 49: { set_trace_file(optarg); } break;
+        case 50: { enable_task_DAG(); } break;
+        case 51: { disable_task_DAG(); } break;
+        case 52: {
+          std::istringstream iss(optarg);
+          iss >> tiled_LU_cutoff_;
+          set_tiled_LU_cutoff(tiled_LU_cutoff_);
+        } break;
         case 'h': { describe_options(); } break;
         case 'v': set_verbose(true); break;
         case 'q': set_verbose(false); break;
@@ -1309,6 +1542,12 @@ namespace strumpack {
                 << std::boolalpha << !use_METIS_NodeND() << ")" << std::endl;
       std::cout << "#          use undocumented Metis routine NodeNDP"
                 << " instead of NodeND" << std::endl;
+      std::cout << "#   --sp_enable_parallel_ND (default "
+                << std::boolalpha << use_parallel_ND() << ")" << std::endl
+                << "#          multithreaded Metis nested dissection"
+                << std::endl;
+      std::cout << "#   --sp_disable_parallel_ND (default "
+                << std::boolalpha << !use_parallel_ND() << ")" << std::endl;
       std::cout << "#   --sp_enable_MUMPS_SYMQAMD (default "
                 << std::boolalpha << use_MUMPS_SYMQAMD() << ")" << std::endl;
       std::cout << "#   --sp_disable_MUMPS_SYMQAMD (default "
@@ -1322,6 +1561,15 @@ namespace strumpack {
       for (int i=0; i<7; i++)
         std::cout << "#      " << i << " " <<
           get_description(get_matching(i)) << std::endl;
+      std::cout << "#   --sp_factorization [lu|cholesky] (default "
+                << get_name(factorization()) << ")" << std::endl
+                << "#          cholesky only for symmetric positive definite"
+                << std::endl;
+      std::cout << "#   --sp_enable_mixed_precision (default "
+                << std::boolalpha << use_mixed_precision() << ")" << std::endl
+                << "#          single precision factorization, used as"
+                << " preconditioner" << std::endl;
+      std::cout << "#   --sp_disable_mixed_precision" << std::endl;
       std::cout << "#   --sp_compression [none|hss|blr|hodlr|lossy]" << std::endl
                 << "#          type of rank-structured compression to use"
                 << std::endl;
@@ -1341,6 +1589,10 @@ namespace strumpack {
       std::cout << "#   --sp_disable_replace_tiny_pivots" << std::endl;
       std::cout << "#   --sp_write_root_front" << std::endl;
       std::cout << "#   --sp_print_root_front_stats" << std::endl;
+      std::cout << "#   --sp_trace_file file (default \""
+                << trace_file() << "\")" << std::endl
+                << "#          write a timeline of the factorization"
+                << " (Chrome trace format)" << std::endl;
       std::cout << "#   --sp_enable_gpu" << std::endl;
       std::cout << "#   --sp_disable_gpu" << std::endl;
       std::cout << "#   --sp_cuda_cutoff (default "
@@ -1349,6 +1601,28 @@ namespace strumpack {
       std::cout << "#   --sp_cuda_streams (default "
                 << cuda_streams() << ")" << std::endl
                 << "#          number of CUDA streams" << std::endl;
+      std::cout << "#   --sp_batch_cutoff (default "
+                << batch_cutoff() << ")" << std::endl
+                << "#          factor small dense fronts level by level"
+                << std::endl;
+      std::cout << "#   --sp_tiled_LU_cutoff (default "
+                << tiled_LU_cutoff() << ")" << std::endl
+                << "#          tiled LU for fronts with larger separator"
+                << std::endl;
+      std::cout << "#   --sp_enable_CB_workspace (default "
+                << std::boolalpha << use_CB_workspace() << ")" << std::endl
+                << "#          preallocated stack for contribution blocks"
+                << std::endl;
+      std::cout << "#   --sp_disable_CB_workspace (default "
+                << std::boolalpha << (!use_CB_workspace()) << ")"
+                << std::endl;
+      std::cout << "#   --sp_enable_task_DAG (default "
+                << std::boolalpha << use_task_DAG() << ")" << std::endl
+                << "#          task graph for the top of the tree"
+                << std::endl;
+      std::cout << "#   --sp_disable_task_DAG (default "
+                << std::boolalpha << (!use_task_DAG()) << ")"
+                << std::endl;
       std::cout << "#   --sp_lossy_precision [1-64] (default "
                 << lossy_precision() << ")" << std::endl
                 << "#          lossy compression precicion" << std::endl;
@@ -1379,19 +1653,29 @@ namespace strumpack {
     int _components = 1;
     int _separator_width = 1;
     bool _use_METIS_NodeNDP = false;
+    bool parallel_ND_ = true;
     bool _use_MUMPS_SYMQAMD = false;
     bool _use_agg_amalg = false;
     MatchingJob _matching_job = MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING;
+    FactorizationType _factorization = FactorizationType::LU;
+    bool _mixed_precision = false;
     bool _log_assembly_tree = false;
     bool _replace_tiny_pivots = false;
     bool _write_root_front = false;
     bool _print_root_front_stats = false;
+    std::string trace_file_;
 
     /** GPU options */
     bool use_gpu_ = true;
     int cuda_cutoff_ = default_cuda_cutoff();
     int cuda_streams_ = default_cuda_streams();
 
+    /** level-batched factorization of small fronts */
+    int batch_cutoff_ = default_batch_cutoff();
+    int tiled_LU_cutoff_ = default_tiled_LU_cutoff();
+    bool CB_workspace_ = true;
+    bool task_DAG_ = false;
+
     /** compression options */
     CompressionType _comp = CompressionType::NONE;
 
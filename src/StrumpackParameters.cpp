@@ -50,31 +50,33 @@ namespace strumpack {
     int task_recursion_cutoff_level = 0;
 #endif
 
-    std::atomic<long long int> flops(0);
-    std::atomic<long long int> bytes(0);
+    ThreadCounter flops(0);
+    ThreadCounter bytes(0);
+    std::atomic<long long int> memory(0);
+    std::atomic<long long int> peak_memory(0);
 
-    std::atomic<long long int> CB_sample_flops(0);
-    std::atomic<long long int> sparse_sample_flops(0);
-    std::atomic<long long int> extraction_flops(0);
-    std::atomic<long long int> ULV_factor_flops(0);
-    std::atomic<long long int> schur_flops(0);
-    std::atomic<long long int> full_rank_flops(0);
-    std::atomic<long long int> random_flops(0);
-    std::atomic<long long int> ID_flops(0);
-    std::atomic<long long int> QR_flops(0);
-    std::atomic<long long int> ortho_flops(0);
-    std::atomic<long long int> reduce_sample_flops(0);
-    std::atomic<long long int> update_sample_flops(0);
-    std::atomic<long long int> hss_solve_flops(0);
+    ThreadCounter CB_sample_flops(0);
+    ThreadCounter sparse_sample_flops(0);
+    ThreadCounter extraction_flops(0);
+    ThreadCounter ULV_factor_flops(0);
+    ThreadCounter schur_flops(0);
+    ThreadCounter full_rank_flops(0);
+    ThreadCounter random_flops(0);
+    ThreadCounter ID_flops(0);
+    ThreadCounter QR_flops(0);
+    ThreadCounter ortho_flops(0);
+    ThreadCounter reduce_sample_flops(0);
+    ThreadCounter update_sample_flops(0);
+    ThreadCounter hss_solve_flops(0);
 
-    std::atomic<long long int> f11_fill_flops(0);
-    std::atomic<long long int> f12_fill_flops(0);
-    std::atomic<long long int> f21_fill_flops(0);
-    std::atomic<long long int> f22_fill_flops(0);
+    ThreadCounter f11_fill_flops(0);
+    ThreadCounter f12_fill_flops(0);
+    ThreadCounter f21_fill_flops(0);
+    ThreadCounter f22_fill_flops(0);
 
-    std::atomic<long long int> f21_mult_flops(0);
-    std::atomic<long long int> invf11_mult_flops(0);
-    std::atomic<long long int> f12_mult_flops(0);
+    ThreadCounter f21_mult_flops(0);
+    ThreadCounter invf11_mult_flops(0);
+    ThreadCounter f12_mult_flops(0);
 
   } // end namespace params
 } // end namespace strumpack
@@ -60,7 +60,8 @@ namespace strumpack { // these are all global variables
   enum class ReturnCode {
     SUCCESS,          /*!< Operation completed successfully. */
     MATRIX_NOT_SET,   /*!< The input matrix was not set.     */
-    REORDERING_ERROR  /*!< The matrix reordering failed.     */
+    REORDERING_ERROR, /*!< The matrix reordering failed.     */
+    FILE_ERROR        /*!< Reading/writing the factors failed. */
   };
 
   namespace params {
@@ -70,31 +71,84 @@ namespace strumpack { // these are all global variables
     extern int num_threads;
     extern int task_recursion_cutoff_level;
 
-    extern std::atomic<long long int> flops;
-    extern std::atomic<long long int> bytes;
-
-    extern std::atomic<long long int> CB_sample_flops;
-    extern std::atomic<long long int> sparse_sample_flops;
-    extern std::atomic<long long int> extraction_flops;
-    extern std::atomic<long long int> ULV_factor_flops;
-    extern std::atomic<long long int> schur_flops;
-    extern std::atomic<long long int> full_rank_flops;
-    extern std::atomic<long long int> random_flops;
-    extern std::atomic<long long int> ID_flops;
-    extern std::atomic<long long int> ortho_flops;
-    extern std::atomic<long long int> QR_flops;
-    extern std::atomic<long long int> reduce_sample_flops;
-    extern std::atomic<long long int> update_sample_flops;
-    extern std::atomic<long long int> hss_solve_flops;
-
-    extern std::atomic<long long int> f11_fill_flops;
-    extern std::atomic<long long int> f12_fill_flops;
-    extern std::atomic<long long int> f21_fill_flops;
-    extern std::atomic<long long int> f22_fill_flops;
-
-    extern std::atomic<long long int> f21_mult_flops;
-    extern std::atomic<long long int> invf11_mult_flops;
-    extern std::atomic<long long int> f12_mult_flops;
+    /**
+     * Event counter, with a separate slot, on its own cache line,
+     * for every thread. Threads only increment their own slot, so
+     * counting from many threads does not cause false sharing. Reads
+     * sum over all slots, and are only exact when no thread is
+     * incrementing concurrently.
+     */
+    class ThreadCounter {
+    public:
+      ThreadCounter(long long int v=0) { *this = v; }
+      ThreadCounter(const ThreadCounter&) = delete;
+
+      ThreadCounter& operator+=(long long int n) {
+        slots_[slot()].v.fetch_add(n, std::memory_order_relaxed);
+        return *this;
+      }
+      ThreadCounter& operator-=(long long int n) { return *this += -n; }
+      ThreadCounter& operator=(long long int v) {
+        for (auto& s : slots_) s.v.store(0, std::memory_order_relaxed);
+        slots_[0].v.store(v, std::memory_order_relaxed);
+        return *this;
+      }
+      long long int load() const {
+        long long int v = 0;
+        for (auto& s : slots_) v += s.v.load(std::memory_order_relaxed);
+        return v;
+      }
+      operator long long int() const { return load(); }
+
+    private:
+      // more threads than slots share slots, which is still correct
+      static const int max_slots = 64;
+      struct alignas(64) Slot { std::atomic<long long int> v; };
+      Slot slots_[max_slots];
+
+      static int slot() {
+        static std::atomic<int> next(0);
+        static thread_local int s = next++ % max_slots;
+        return s;
+      }
+    };
+
+    extern ThreadCounter flops;
+    extern ThreadCounter bytes;
+
+    // memory (bytes) currently allocated for dense matrices, and the
+    // peak since the last reset, shared by all threads
+    extern std::atomic<long long int> memory;
+    extern std::atomic<long long int> peak_memory;
+
+    inline void add_memory(long long int n) {
+      auto m = (memory += n);
+      auto p = peak_memory.load();
+      while (m > p && !peak_memory.compare_exchange_weak(p, m)) {}
+    }
+
+    extern ThreadCounter CB_sample_flops;
+    extern ThreadCounter sparse_sample_flops;
+    extern ThreadCounter extraction_flops;
+    extern ThreadCounter ULV_factor_flops;
+    extern ThreadCounter schur_flops;
+    extern ThreadCounter full_rank_flops;
+    extern ThreadCounter random_flops;
+    extern ThreadCounter ID_flops;
+    extern ThreadCounter ortho_flops;
+    extern ThreadCounter QR_flops;
+    extern ThreadCounter reduce_sample_flops;
+    extern ThreadCounter update_sample_flops;
+    extern ThreadCounter hss_solve_flops;
+
+    extern ThreadCounter f11_fill_flops;
+    extern ThreadCounter f12_fill_flops;
+    extern ThreadCounter f21_fill_flops;
+    extern ThreadCounter f22_fill_flops;
+
+    extern ThreadCounter f21_mult_flops;
+    extern ThreadCounter invf11_mult_flops;
+    extern ThreadCounter f12_mult_flops;
 
 #endif //DOXYGEN_SHOULD_SKIP_THIS
 
@@ -106,6 +160,10 @@ namespace strumpack { // these are all global variables
   strumpack::params::flops += n;
 #define STRUMPACK_BYTES(n)                      \
   strumpack::params::bytes += n;
+#define STRUMPACK_ADD_MEMORY(n)                 \
+  strumpack::params::add_memory(n);
+#define STRUMPACK_SUB_MEMORY(n)                 \
+  strumpack::params::memory -= (n);
 #define STRUMPACK_ID_FLOPS(n)                   \
   strumpack::params::ID_flops += n;
 #define STRUMPACK_QR_FLOPS(n)                   \
@@ -151,6 +209,8 @@ namespace strumpack { // these are all global variables
 #else
 #define STRUMPACK_FLOPS(n) void(0);
 #define STRUMPACK_BYTES(n) void(0);
+#define STRUMPACK_ADD_MEMORY(n) void(0);
+#define STRUMPACK_SUB_MEMORY(n) void(0);
 #define STRUMPACK_ID_FLOPS(n) void(0);
 #define STRUMPACK_QR_FLOPS(n) void(0);
 #define STRUMPACK_ORTHO_FLOPS(n) void(0);
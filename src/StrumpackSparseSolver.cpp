@@ -308,6 +308,45 @@ extern "C" {
     }
   }
 
+  void STRUMPACK_update_csr_matrix_values
+  (STRUMPACK_SparseSolver S, const void* N, const void* row_ptr,
+   const void* col_ind, const void* values, int symm) {
+    switch (S.precision) {
+    case STRUMPACK_FLOAT:
+      CASTS(S.solver)->update_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CRES(values), symm);
+      break;
+    case STRUMPACK_DOUBLE:
+      CASTD(S.solver)->update_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CRED(values), symm);
+      break;
+    case STRUMPACK_FLOATCOMPLEX:
+      CASTC(S.solver)->update_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CREC(values), symm);
+      break;
+    case STRUMPACK_DOUBLECOMPLEX:
+      CASTZ(S.solver)->update_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CREZ(values), symm);
+      break;
+    case STRUMPACK_FLOAT_64:
+      CASTS64(S.solver)->update_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CRES(values), symm);
+      break;
+    case STRUMPACK_DOUBLE_64:
+      CASTD64(S.solver)->update_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CRED(values), symm);
+      break;
+    case STRUMPACK_FLOATCOMPLEX_64:
+      CASTC64(S.solver)->update_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CREC(values), symm);
+      break;
+    case STRUMPACK_DOUBLECOMPLEX_64:
+      CASTZ64(S.solver)->update_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CREZ(values), symm);
+      break;
+    }
+  }
+
 #if defined(STRUMPACK_USE_MPI)
   void STRUMPACK_set_distributed_csr_matrix
   (STRUMPACK_SparseSolver S, const void* N, const void* row_ptr,
@@ -352,6 +391,49 @@ extern "C" {
     }
   }
 
+  void STRUMPACK_update_distributed_csr_matrix_values
+  (STRUMPACK_SparseSolver S, const void* N, const void* row_ptr,
+   const void* col_ind, const void* values, const void* dist, int symm) {
+    if (S.interface != STRUMPACK_MPI_DIST) {
+      std::cerr << "ERROR: interface != STRUMPACK_MPI_DIST" << std::endl;
+      return;
+    }
+    switch (S.precision) {
+    case STRUMPACK_FLOAT:
+      CASTSMPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CRES(values), CREI(dist), symm);
+      break;
+    case STRUMPACK_DOUBLE:
+      CASTDMPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CRED(values), CREI(dist), symm);
+      break;
+    case STRUMPACK_FLOATCOMPLEX:
+      CASTCMPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CREC(values), CREI(dist), symm);
+      break;
+    case STRUMPACK_DOUBLECOMPLEX:
+      CASTZMPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CREI(N), CREI(row_ptr), CREI(col_ind), CREZ(values), CREI(dist), symm);
+      break;
+    case STRUMPACK_FLOAT_64:
+      CASTS64MPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CRES(values), CRE64(dist), symm);
+      break;
+    case STRUMPACK_DOUBLE_64:
+      CASTD64MPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CRED(values), CRE64(dist), symm);
+      break;
+    case STRUMPACK_FLOATCOMPLEX_64:
+      CASTC64MPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CREC(values), CRE64(dist), symm);
+      break;
+    case STRUMPACK_DOUBLECOMPLEX_64:
+      CASTZ64MPIDIST(S.solver)->update_distributed_csr_matrix_values
+        (*CRE64(N), CRE64(row_ptr), CRE64(col_ind), CREZ(values), CRE64(dist), symm);
+      break;
+    }
+  }
+
   void STRUMPACK_set_MPIAIJ_matrix
   (STRUMPACK_SparseSolver S, const void* n, const void* d_ptr,
    const void* d_ind, const void* d_val, const void* o_ptr, const void* o_ind,
@@ -467,6 +549,20 @@ extern "C" {
     return static_cast<STRUMPACK_RETURN_CODE>(c);
   }
 
+  STRUMPACK_RETURN_CODE STRUMPACK_save_factors
+  (STRUMPACK_SparseSolver S, const char* filename) {
+    ReturnCode c = ReturnCode::SUCCESS;
+    switch_precision_return(save_factors(filename), c);
+    return static_cast<STRUMPACK_RETURN_CODE>(c);
+  }
+
+  STRUMPACK_RETURN_CODE STRUMPACK_load_factors
+  (STRUMPACK_SparseSolver S, const char* filename) {
+    ReturnCode c = ReturnCode::SUCCESS;
+    switch_precision_return(load_factors(filename), c);
+    return static_cast<STRUMPACK_RETURN_CODE>(c);
+  }
+
 
 
   /*************************************************************
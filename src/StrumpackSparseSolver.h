@@ -88,7 +88,8 @@ typedef enum {
 
 typedef enum {
   STRUMPACK_LINEAR=0,
-  STRUMPACK_MERSENNE=1
+  STRUMPACK_MERSENNE=1,
+  STRUMPACK_PHILOX=2
 } STRUMPACK_RANDOM_ENGINE;
 
 typedef enum {
@@ -104,7 +105,8 @@ typedef enum {
 typedef enum {
   STRUMPACK_SUCCESS=0,
   STRUMPACK_MATRIX_NOT_SET=1,
-  STRUMPACK_REORDERING_ERROR=2
+  STRUMPACK_REORDERING_ERROR=2,
+  STRUMPACK_FILE_ERROR=3
 } STRUMPACK_RETURN_CODE;
 
 
@@ -128,12 +130,24 @@ extern "C" {
   (STRUMPACK_SparseSolver S, const void* N, const void* row_ptr,
    const void* col_ind, const void* values, int symmetric_pattern);
 
+  /* Replace the values of the matrix, with the same sparsity pattern
+   * as the matrix set before, and reuse the reordering and symbolic
+   * factorization in the next call to STRUMPACK_factor. */
+  void STRUMPACK_update_csr_matrix_values
+  (STRUMPACK_SparseSolver S, const void* N, const void* row_ptr,
+   const void* col_ind, const void* values, int symmetric_pattern);
+
 #if defined(STRUMPACK_USE_MPI)
   void STRUMPACK_set_distributed_csr_matrix
   (STRUMPACK_SparseSolver S, const void* local_rows, const void* row_ptr,
    const void* col_ind, const void* values, const void* dist,
    int symmetric_pattern);
 
+  void STRUMPACK_update_distributed_csr_matrix_values
+  (STRUMPACK_SparseSolver S, const void* local_rows, const void* row_ptr,
+   const void* col_ind, const void* values, const void* dist,
+   int symmetric_pattern);
+
   void STRUMPACK_set_MPIAIJ_matrix
   (STRUMPACK_SparseSolver S, const void* n, const void* d_ptr,
    const void* d_ind, const void* d_val, const void* o_ptr,
@@ -152,6 +166,14 @@ extern "C" {
 
   STRUMPACK_RETURN_CODE STRUMPACK_factor(STRUMPACK_SparseSolver S);
 
+  /* Write the factors (and permutations/scaling) to a binary file,
+   * or read them back, after setting the same matrix, see
+   * StrumpackSparseSolver::save_factors/load_factors. */
+  STRUMPACK_RETURN_CODE STRUMPACK_save_factors
+  (STRUMPACK_SparseSolver S, const char* filename);
+  STRUMPACK_RETURN_CODE STRUMPACK_load_factors
+  (STRUMPACK_SparseSolver S, const char* filename);
+
   /*************************************************************
    ** Set options **********************************************
    ************************************************************/
@@ -34,6 +34,7 @@
 #define STRUMPACK_SOLVER_H
 
 #include <sstream>
+#include <fstream>
 #include <getopt.h>
 #include <new>
 #include <cmath>
@@ -96,6 +97,7 @@ namespace strumpack {
     using Reord_t = MatrixReordering<scalar_t,integer_t>;
     using DenseM_t = DenseMatrix<scalar_t>;
     using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+    using scalar_lp_t = typename LowPrecisionType<scalar_t>::value_type;
 
   public:
 
@@ -171,6 +173,44 @@ namespace strumpack {
     (integer_t N, const integer_t* row_ptr, const integer_t* col_ind,
      const scalar_t* values, bool symmetric_pattern=false);
 
+    /**
+     * Replace the numerical values of the matrix associated with this
+     * solver, keeping the (MC64) matching, the fill-reducing
+     * reordering and the symbolic factorization that were computed
+     * for the previous matrix. The sparsity pattern of A should be
+     * exactly the same as that of the matrix that was passed to
+     * set_matrix or set_csr_matrix. The cached column permutation,
+     * row/column scaling and nested dissection permutation are
+     * applied to the new values, and the next call to factor() will
+     * go straight to the numerical factorization. If the matrix was
+     * not reordered yet, this is the same as calling set_matrix.
+     *
+     * \param A A CSRMatrix<scalar_t,integer_t> object with the same
+     * sparsity pattern as the current matrix, will internally be
+     * duplicated
+     * \see set_matrix, factor
+     */
+    virtual void update_matrix_values(const CSRMatrix<scalar_t,integer_t>& A);
+
+    /**
+     * Replace the numerical values of the matrix associated with this
+     * solver, keeping the reordering and symbolic factorization. See
+     * update_matrix_values(const CSRMatrix<scalar_t,integer_t>&).
+     *
+     * \param N number of rows and columns of the CSR input matrix.
+     * \param row_ptr indices in col_ind and values for the start of
+     * each row. Should be the same as for the previous matrix.
+     * \param col_ind column indices of each nonzero. Should be the
+     * same as for the previous matrix.
+     * \param values new nonzero values
+     * \param symmetric_pattern denotes whether the sparsity
+     * __pattern__ of the input matrix is symmetric
+     * \see set_csr_matrix, factor
+     */
+    virtual void update_matrix_values
+    (integer_t N, const integer_t* row_ptr, const integer_t* col_ind,
+     const scalar_t* values, bool symmetric_pattern=false);
+
     /**
      * Compute matrix reorderings for numerical stability and to
      * reduce fill-in.
@@ -218,6 +258,35 @@ namespace strumpack {
      */
     ReturnCode factor();
 
+    /**
+     * Write the numerical factors, together with the matching,
+     * scaling and fill-reducing permutations, to a binary file. If
+     * the matrix was not factored yet, this will call factor()
+     * first. The factors can later be read back with load_factors,
+     * avoiding a new reordering and factorization. This is only
+     * supported without compression (only dense fronts) and without
+     * mixed precision.
+     *
+     * \param filename name of the file to write
+     * \return error code
+     * \see load_factors, factor
+     */
+    virtual ReturnCode save_factors(const std::string& filename);
+
+    /**
+     * Read the factors written by save_factors. A matrix, with the
+     * same values as the matrix used to write the factors, needs to
+     * be set before calling this routine (it is used for iterative
+     * refinement or Krylov solvers). The matching and factorization
+     * type options are taken from the file. After this, solve can be
+     * called directly.
+     *
+     * \param filename name of the file to read
+     * \return error code
+     * \see save_factors, set_matrix, solve
+     */
+    virtual ReturnCode load_factors(const std::string& filename);
+
     /**
      * Solve a linear system with a single right-hand side. Before
      * being able to solve a linear system, the matrix needs to be
@@ -320,20 +389,48 @@ namespace strumpack {
      * StrumpackSparseSolverMPIDist distributed memory solvers, this
      * routine is collective on the MPI communicator.
      */
-    std::size_t factor_nonzeros() const { return tree()->factor_nonzeros(); }
+    std::size_t factor_nonzeros() const {
+      return mixed_ ? tree_lp_->factor_nonzeros() : tree()->factor_nonzeros();
+    }
 
     /**
      * Return the amount of memory taken by the sparse factorization
      * factors. This is the fill-in. It is simply computed as
-     * factor_nonzeros() * sizeof(scalar_t), so it does not include
-     * any overhead from the metadata for the datastructures. This
-     * should be called after the factorization. For the
-     * StrumpackSparseSolverMPI and StrumpackSparseSolverMPIDist
-     * distributed memory solvers, this routine is collective on the
-     * MPI communicator.
+     * factor_nonzeros() * sizeof(scalar_t), or sizeof(float) /
+     * sizeof(std::complex<float>) with mixed precision, so it does
+     * not include any overhead from the metadata for the
+     * datastructures. This should be called after the
+     * factorization. For the StrumpackSparseSolverMPI and
+     * StrumpackSparseSolverMPIDist distributed memory solvers, this
+     * routine is collective on the MPI communicator.
      */
     std::size_t factor_memory() const
-    { return tree()->factor_nonzeros() * sizeof(scalar_t); }
+    { return factor_nonzeros() * factor_scalar_size(); }
+
+    /**
+     * Predict the peak memory (in bytes) used by the numerical
+     * factorization, for the factors, the frontal matrices and the
+     * contribution blocks. This is computed from the symbolic
+     * factorization, for the current options, and can be called
+     * after reorder() and before factor(). It assumes all fronts are
+     * dense, so with compression the actual peak will differ. For
+     * the StrumpackSparseSolverMPI and StrumpackSparseSolverMPIDist
+     * distributed memory solvers, this returns the maximum over all
+     * processes, and it is collective on the MPI communicator.
+     */
+    std::size_t peak_memory_estimate() const;
+
+    /**
+     * Return the peak memory (in bytes) measured during the last
+     * numerical factorization. This counts all memory allocated for
+     * dense matrices, in any thread, including the factors, the
+     * frontal matrices, contribution blocks and temporary
+     * workspace. For the distributed memory solvers this is the
+     * maximum over all processes. This is only available when
+     * STRUMPACK was built with STRUMPACK_COUNT_FLOPS, otherwise this
+     * returns 0.
+     */
+    std::size_t peak_memory() const { return peak_mem_; }
 
     /**
      * Return the number of iterations performed by the outer (Krylov)
@@ -357,6 +454,7 @@ namespace strumpack {
     virtual int compute_reordering
     (int nx, int ny, int nz, int components, int width);
     virtual void separator_reordering();
+    virtual void permute_matrix_values();
 
     virtual SpMat_t* matrix() { return mat_.get(); }
     virtual Reord_t* reordering() { return nd_.get(); }
@@ -369,6 +467,10 @@ namespace strumpack {
     inline long long dense_factor_nonzeros() const {
       return tree()->dense_factor_nonzeros();
     }
+    inline std::size_t factor_scalar_size() const {
+      return mixed_ ? sizeof(scalar_lp_t) : sizeof(scalar_t);
+    }
+    void multifrontal_solve(DenseM_t& x) const;
     void print_solve_stats(TaskTimer& t) const;
     virtual void perf_counters_start();
     virtual void perf_counters_stop(const std::string& s);
@@ -389,6 +491,7 @@ namespace strumpack {
     bool factored_ = false;
     bool reordered_ = false;
     int Krylov_its_ = 0;
+    std::size_t peak_mem_ = 0;
 
 #if defined(STRUMPACK_USE_PAPI)
     float rtime_ = 0., ptime_ = 0.;
@@ -397,11 +500,20 @@ namespace strumpack {
 #if defined(STRUMPACK_COUNT_FLOPS)
     long long int f0_ = 0, ftot_ = 0, fmin_ = 0, fmax_ = 0;
     long long int b0_ = 0, btot_ = 0, bmin_ = 0, bmax_ = 0;
+    long long int mmin_ = 0, mmax_ = 0;
 #endif
   private:
     std::unique_ptr<CSRMatrix<scalar_t,integer_t>> mat_;
     std::unique_ptr<MatrixReordering<scalar_t,integer_t>> nd_;
     std::unique_ptr<EliminationTree<scalar_t,integer_t>> tree_;
+
+    // single precision copy of the matrix and the tree, used when
+    // mixed precision is enabled, see setup_tree
+    bool mixed_ = false;
+    std::unique_ptr<CSRMatrix<scalar_lp_t,integer_t>> mat_lp_;
+    std::unique_ptr<EliminationTree<scalar_lp_t,integer_t>> tree_lp_;
+
+    SPOptions<scalar_lp_t> low_precision_options() const;
   };
 
   template<typename scalar_t,typename integer_t>
@@ -458,6 +570,80 @@ namespace strumpack {
   StrumpackSparseSolver<scalar_t,integer_t>::setup_tree() {
     tree_ = std::unique_ptr<EliminationTree<scalar_t,integer_t>>
       (new EliminationTree<scalar_t,integer_t>(opts_, *mat_, nd_->tree()));
+    mixed_ = opts_.use_mixed_precision() &&
+      !std::is_same<scalar_t,scalar_lp_t>::value &&
+      opts_.compression() == CompressionType::NONE;
+    if (opts_.use_mixed_precision() && !mixed_ && is_root_)
+      std::cerr << "# WARNING: mixed precision requires double precision"
+                << " and no compression, ignored" << std::endl;
+    if (!mixed_) {
+      mat_lp_.reset();
+      tree_lp_.reset();
+      return;
+    }
+    // the single precision tree has the same structure, the values
+    // of mat_lp_ are copied from mat_ before each factorization
+    auto n = mat_->size();
+    auto nnz = mat_->nnz();
+    mat_lp_ = std::unique_ptr<CSRMatrix<scalar_lp_t,integer_t>>
+      (new CSRMatrix<scalar_lp_t,integer_t>(n, nnz));
+    std::copy(mat_->ptr(), mat_->ptr()+n+1, mat_lp_->ptr());
+    std::copy(mat_->ind(), mat_->ind()+nnz, mat_lp_->ind());
+    tree_lp_ = std::unique_ptr<EliminationTree<scalar_lp_t,integer_t>>
+      (new EliminationTree<scalar_lp_t,integer_t>
+       (low_precision_options(), *mat_lp_, nd_->tree()));
+  }
+
+  template<typename scalar_t,typename integer_t>
+  SPOptions<typename LowPrecisionType<scalar_t>::value_type>
+  StrumpackSparseSolver<scalar_t,integer_t>::low_precision_options() const {
+    // only the options relevant for the dense fronts
+    SPOptions<scalar_lp_t> o;
+    o.set_verbose(false);
+    o.set_compression(CompressionType::NONE);
+    o.set_factorization(opts_.factorization());
+    if (opts_.replace_tiny_pivots()) o.enable_replace_tiny_pivots();
+    if (opts_.use_gpu()) o.enable_gpu();
+    else o.disable_gpu();
+    o.set_cuda_cutoff(opts_.cuda_cutoff());
+    o.set_cuda_streams(opts_.cuda_streams());
+    o.set_batch_cutoff(opts_.batch_cutoff());
+    o.set_tiled_LU_cutoff(opts_.tiled_LU_cutoff());
+    if (opts_.use_CB_workspace()) o.enable_CB_workspace();
+    else o.disable_CB_workspace();
+    if (opts_.use_task_DAG()) o.enable_task_DAG();
+    else o.disable_task_DAG();
+    o.set_print_root_front_stats(opts_.print_root_front_stats());
+    return o;
+  }
+
+  template<typename scalar_t,typename integer_t> std::size_t
+  StrumpackSparseSolver<scalar_t,integer_t>::peak_memory_estimate() const {
+    if (!reordered_) return 0;
+    return factor_scalar_size() *
+      (mixed_ ? tree_lp_->dense_peak_memory(low_precision_options()) :
+       tree()->dense_peak_memory(opts_));
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolver<scalar_t,integer_t>::multifrontal_solve
+  (DenseM_t& x) const {
+    if (!mixed_) {
+      tree()->multifrontal_solve(x);
+      return;
+    }
+    auto n = x.rows();
+    auto d = x.cols();
+    DenseMatrix<scalar_lp_t> xlp(n, d);
+    for (std::size_t j=0; j<d; j++)
+#pragma omp parallel for
+      for (std::size_t i=0; i<n; i++)
+        xlp(i, j) = scalar_lp_t(x(i, j));
+    tree_lp_->multifrontal_solve(xlp);
+    for (std::size_t j=0; j<d; j++)
+#pragma omp parallel for
+      for (std::size_t i=0; i<n; i++)
+        x(i, j) = scalar_t(xlp(i, j));
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -519,6 +705,7 @@ namespace strumpack {
 #if defined(STRUMPACK_COUNT_FLOPS)
     f0_ = params::flops;
     b0_ = params::bytes;
+    params::peak_memory = params::memory.load();
 #endif
   }
 
@@ -560,6 +747,7 @@ namespace strumpack {
 #if defined(STRUMPACK_COUNT_FLOPS)
     fmin_ = fmax_ = ftot_ = params::flops - f0_;
     bmin_ = bmax_ = btot_ = params::bytes - b0_;
+    mmin_ = mmax_ = params::peak_memory;
 #endif
   }
 
@@ -611,10 +799,70 @@ namespace strumpack {
     factored_ = reordered_ = false;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolver<scalar_t,integer_t>::update_matrix_values
+  (const CSRMatrix<scalar_t,integer_t>& A) {
+    if (!reordered_) {
+      set_matrix(A);
+      return;
+    }
+    mat_ = std::unique_ptr<CSRMatrix<scalar_t,integer_t>>
+      (new CSRMatrix<scalar_t,integer_t>(A));
+    permute_matrix_values();
+    factored_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolver<scalar_t,integer_t>::update_matrix_values
+  (integer_t N, const integer_t* row_ptr, const integer_t* col_ind,
+   const scalar_t* values, bool symmetric_pattern) {
+    if (!reordered_) {
+      set_csr_matrix(N, row_ptr, col_ind, values, symmetric_pattern);
+      return;
+    }
+    mat_ = std::unique_ptr<CSRMatrix<scalar_t,integer_t>>
+      (new CSRMatrix<scalar_t,integer_t>
+       (N, row_ptr, col_ind, values, symmetric_pattern));
+    permute_matrix_values();
+    factored_ = false;
+  }
+
+  /**
+   * Apply the matching, scaling and fill-reducing permutation that
+   * were computed in reorder() to a new matrix with the same sparsity
+   * pattern. The nested dissection permutation in reordering()
+   * already includes the separator reordering.
+   */
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolver<scalar_t,integer_t>::permute_matrix_values() {
+    TaskTimer t("permute-matrix-values");
+    t.start();
+    if (opts_.matching() != MatchingJob::NONE) {
+      if (opts_.matching() == MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING)
+        matrix()->apply_scaling(matching_Dr_, matching_Dc_);
+      matrix()->apply_column_permutation(matching_cperm_);
+      matrix()->set_symm_sparse(false);
+    }
+    matrix()->symmetrize_sparsity();
+    matrix()->permute(reordering()->iperm(), reordering()->perm());
+    t.stop();
+    if (opts_.verbose() && is_root_)
+      std::cout << "# reusing reordering and symbolic factorization,"
+                << " permute time = " << t.elapsed() << std::endl;
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   StrumpackSparseSolver<scalar_t,integer_t>::reorder
   (int nx, int ny, int nz, int components, int width) {
     if (!matrix()) return ReturnCode::MATRIX_NOT_SET;
+    if (opts_.factorization() == FactorizationType::CHOLESKY &&
+        opts_.matching() != MatchingJob::NONE) {
+      // the column permutation would destroy the symmetry
+      if (opts_.verbose() && is_root_)
+        std::cout << "# disabling matching for Cholesky factorization"
+                  << std::endl;
+      opts_.set_matching(MatchingJob::NONE);
+    }
     TaskTimer t1("permute-scale");
     int ierr;
     if (opts_.matching() != MatchingJob::NONE) {
@@ -799,21 +1047,41 @@ namespace strumpack {
       ReturnCode ierr = reorder();
       if (ierr != ReturnCode::SUCCESS) return ierr;
     }
-    float dfnnz = 0.;
+    float dfnnz = 0., pmem = 0.;
     if (opts_.verbose()) {
       dfnnz = dense_factor_nonzeros();
+      pmem = peak_memory_estimate();
       if (is_root_) {
         std::cout << "# multifrontal factorization:" << std::endl;
         std::cout << "#   - estimated memory usage (exact solver) = "
-                  << dfnnz * sizeof(scalar_t) / 1.e6 << " MB" << std::endl;
+                  << dfnnz * factor_scalar_size() / 1.e6 << " MB"
+                  << std::endl;
+        std::cout << "#   - estimated peak memory (exact solver) = "
+                  << pmem / 1.e6 << " MB" << std::endl;
+        if (mixed_)
+          std::cout << "#   - mixed precision, factorization in single"
+                    << " precision" << std::endl;
       }
     }
     perf_counters_start();
     flop_breakdown_reset();
+    if (!opts_.trace_file().empty()) TraceLog::enable();
     TaskTimer t1("factorization", [&]() {
-        tree()->multifrontal_factorization(*matrix(), opts_);
+        if (mixed_) {
+          std::copy(matrix()->val(), matrix()->val()+matrix()->nnz(),
+                    mat_lp_->val());
+          tree_lp_->multifrontal_factorization
+            (*mat_lp_, low_precision_options());
+        } else tree()->multifrontal_factorization(*matrix(), opts_);
       });
+    if (!opts_.trace_file().empty()) {
+      TraceLog::disable();
+      TraceLog::write(opts_.trace_file());
+    }
     perf_counters_stop("numerical factorization");
+#if defined(STRUMPACK_COUNT_FLOPS)
+    peak_mem_ = mmax_;
+#endif
     if (opts_.verbose()) {
       auto fnnz = factor_nonzeros();
       auto max_rank = maximum_rank();
@@ -822,8 +1090,12 @@ namespace strumpack {
         std::cout << "#   - factor nonzeros = "
                   << number_format_with_commas(fnnz) << std::endl;
         std::cout << "#   - factor memory = "
-                  << float(fnnz) * sizeof(scalar_t) / 1.e6 << " MB" << std::endl;
+                  << float(fnnz) * factor_scalar_size() / 1.e6 << " MB"
+                  << std::endl;
 #if defined(STRUMPACK_COUNT_FLOPS)
+        std::cout << "#   - peak memory = " << double(mmax_) / 1.e6
+                  << " MB, min = " << double(mmin_) / 1.e6
+                  << " MB" << std::endl;
         std::cout << "#   - factor flops = " << double(ftot_) << " min = "
                   << double(fmin_) << " max = " << double(fmax_)
                   << std::endl;
@@ -873,6 +1145,139 @@ namespace strumpack {
     return ReturnCode::SUCCESS;
   }
 
+  template<typename T> void write_binary_vector
+  (std::ostream& os, const std::vector<T>& v) {
+    std::uint64_t n = v.size();
+    os.write((const char*)&n, sizeof(n));
+    os.write((const char*)v.data(), sizeof(T)*n);
+  }
+  template<typename T> bool read_binary_vector
+  (std::istream& is, std::vector<T>& v) {
+    std::uint64_t n = 0;
+    is.read((char*)&n, sizeof(n));
+    if (!is.good()) return false;
+    v.resize(n);
+    is.read((char*)v.data(), sizeof(T)*n);
+    return is.good();
+  }
+  template<typename scalar_t> char scalar_type_char() { return 'd'; }
+  template<> inline char scalar_type_char<float>() { return 's'; }
+  template<> inline char scalar_type_char<std::complex<float>>() { return 'c'; }
+  template<> inline char scalar_type_char<std::complex<double>>() { return 'z'; }
+
+  /**
+   * File layout: magic, version, scalar type, sizeof(integer_t),
+   * matrix size, factorization type and matching job, followed by
+   * the matching permutation and scaling vectors, the fill-reducing
+   * permutation and its inverse, and finally all fronts in
+   * depth-first order, see EliminationTree::write_factors.
+   */
+  template<typename scalar_t,typename integer_t> ReturnCode
+  StrumpackSparseSolver<scalar_t,integer_t>::save_factors
+  (const std::string& filename) {
+    if (!factored_) {
+      auto ierr = factor();
+      if (ierr != ReturnCode::SUCCESS) return ierr;
+    }
+    if (opts_.compression() != CompressionType::NONE || mixed_) {
+      std::cerr << "ERROR: save_factors only supported without"
+                << " compression and mixed precision" << std::endl;
+      return ReturnCode::FILE_ERROR;
+    }
+    std::ofstream os(filename, std::ios::binary);
+    if (!os.good()) {
+      std::cerr << "ERROR: could not open " << filename << std::endl;
+      return ReturnCode::FILE_ERROR;
+    }
+    TaskTimer t("save-factors");
+    t.start();
+    std::int32_t hdr[5] =
+      {1, scalar_type_char<scalar_t>(), int(sizeof(integer_t)),
+       int(opts_.factorization()), int(opts_.matching())};
+    std::int64_t n = matrix()->size();
+    os.write("STRUMPACK", 9);
+    os.write((const char*)hdr, sizeof(hdr));
+    os.write((const char*)&n, sizeof(n));
+    write_binary_vector(os, matching_cperm_);
+    write_binary_vector(os, matching_Dr_);
+    write_binary_vector(os, matching_Dc_);
+    write_binary_vector(os, reordering()->perm());
+    write_binary_vector(os, reordering()->iperm());
+    if (!tree()->write_factors(os) || !os.good()) {
+      std::cerr << "ERROR: writing factors to " << filename
+                << " failed" << std::endl;
+      return ReturnCode::FILE_ERROR;
+    }
+    t.stop();
+    if (opts_.verbose() && is_root_)
+      std::cout << "# wrote factors to " << filename << ", "
+                << double(os.tellp()) / 1.e6 << " MB, time = "
+                << t.elapsed() << std::endl;
+    return ReturnCode::SUCCESS;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  StrumpackSparseSolver<scalar_t,integer_t>::load_factors
+  (const std::string& filename) {
+    if (!matrix()) return ReturnCode::MATRIX_NOT_SET;
+    std::ifstream is(filename, std::ios::binary);
+    if (!is.good()) {
+      std::cerr << "ERROR: could not open " << filename << std::endl;
+      return ReturnCode::FILE_ERROR;
+    }
+    TaskTimer t("load-factors");
+    t.start();
+    char magic[9];
+    std::int32_t hdr[5];
+    std::int64_t n = 0;
+    is.read(magic, sizeof(magic));
+    is.read((char*)hdr, sizeof(hdr));
+    is.read((char*)&n, sizeof(n));
+    if (!is.good() ||
+        std::string(magic, 9) != "STRUMPACK" || hdr[0] != 1 ||
+        hdr[1] != scalar_type_char<scalar_t>() ||
+        hdr[2] != int(sizeof(integer_t)) ||
+        n != matrix()->size()) {
+      std::cerr << "ERROR: " << filename << " is not a factors file"
+                << " compatible with this solver/matrix" << std::endl;
+      return ReturnCode::FILE_ERROR;
+    }
+    std::vector<integer_t> perm, iperm;
+    if (!read_binary_vector(is, matching_cperm_) ||
+        !read_binary_vector(is, matching_Dr_) ||
+        !read_binary_vector(is, matching_Dc_) ||
+        !read_binary_vector(is, perm) || !read_binary_vector(is, iperm) ||
+        perm.size() != std::size_t(n) || iperm.size() != std::size_t(n)) {
+      std::cerr << "ERROR: reading permutations from " << filename
+                << " failed" << std::endl;
+      return ReturnCode::FILE_ERROR;
+    }
+    opts_.set_factorization(FactorizationType(hdr[3]));
+    opts_.set_matching(MatchingJob(hdr[4]));
+    opts_.set_compression(CompressionType::NONE);
+    setup_reordering();
+    reordering()->perm() = std::move(perm);
+    reordering()->iperm() = std::move(iperm);
+    permute_matrix_values();
+    tree_ = std::unique_ptr<EliminationTree<scalar_t,integer_t>>
+      (new EliminationTree<scalar_t,integer_t>());
+    mixed_ = false;
+    mat_lp_.reset();
+    tree_lp_.reset();
+    if (!tree_->read_factors(is)) {
+      std::cerr << "ERROR: reading factors from " << filename
+                << " failed" << std::endl;
+      factored_ = reordered_ = false;
+      return ReturnCode::FILE_ERROR;
+    }
+    reordered_ = factored_ = true;
+    t.stop();
+    if (opts_.verbose() && is_root_)
+      std::cout << "# read factors from " << filename
+                << ", time = " << t.elapsed() << std::endl;
+    return ReturnCode::SUCCESS;
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   StrumpackSparseSolver<scalar_t,integer_t>::solve
   (const scalar_t* b, scalar_t* x, bool use_initial_guess) {
@@ -963,11 +1368,32 @@ namespace strumpack {
     };
     auto MFsolve = [&](scalar_t* w) {
       DenseMW_t X(x.rows(), 1, w, x.ld());
-      tree()->multifrontal_solve(X);
+      multifrontal_solve(X);
     };
+
+    // multiple right hand sides, all columns are solved together
+    auto spmm = [&](const DenseM_t& x, DenseM_t& y) {
+      matrix()->spmv(x, y);
+    };
+    auto block_gmres_solve =
+      [&](const std::function<void(DenseM_t&)>& prec) {
+      BlockGMRes<scalar_t>
+      (spmm, prec, x, bloc, opts_.rel_tol(), opts_.abs_tol(),
+       Krylov_its_, opts_.maxit(), opts_.gmres_restart(),
+       opts_.GramSchmidt_type(), use_initial_guess,
+       opts_.verbose() && is_root_);
+    };
+    auto block_bicgstab_solve =
+      [&](const std::function<void(DenseM_t&)>& prec) {
+      BlockBiCGStab<scalar_t>
+      (spmm, prec, x, bloc, opts_.rel_tol(), opts_.abs_tol(),
+       Krylov_its_, opts_.maxit(), use_initial_guess,
+       opts_.verbose() && is_root_);
+    };
+    auto block_MFsolve = [&](DenseM_t& w) { multifrontal_solve(w); };
     auto refine = [&]() {
       IterativeRefinement<scalar_t,integer_t>
-      (*matrix(), [&](DenseM_t& w) { tree()->multifrontal_solve(w); },
+      (*matrix(), [&](DenseM_t& w) { multifrontal_solve(w); },
        x, bloc, opts_.rel_tol(), opts_.abs_tol(),
        Krylov_its_, opts_.maxit(), use_initial_guess,
        opts_.verbose() && is_root_);
@@ -975,33 +1401,33 @@ namespace strumpack {
 
     switch (opts_.Krylov_solver()) {
     case KrylovSolver::AUTO: {
-      if (opts_.compression() != CompressionType::NONE
-          && x.cols() == 1)
-        gmres_solve(MFsolve);
-      else refine();
+      if (opts_.compression() != CompressionType::NONE) {
+        if (x.cols() == 1) gmres_solve(MFsolve);
+        else block_gmres_solve(block_MFsolve);
+      } else refine();
     }; break;
     case KrylovSolver::DIRECT: {
       x = bloc;
-      tree()->multifrontal_solve(x);
+      multifrontal_solve(x);
     }; break;
     case KrylovSolver::REFINE: {
       refine();
     }; break;
     case KrylovSolver::PREC_GMRES: {
-      assert(x.cols() == 1);
-      gmres_solve(MFsolve);
+      if (x.cols() == 1) gmres_solve(MFsolve);
+      else block_gmres_solve(block_MFsolve);
     }; break;
     case KrylovSolver::GMRES: {
-      assert(x.cols() == 1);
-      gmres_solve([](scalar_t* x){});
+      if (x.cols() == 1) gmres_solve([](scalar_t* x){});
+      else block_gmres_solve([](DenseM_t& x){});
     }; break;
     case KrylovSolver::PREC_BICGSTAB: {
-      assert(x.cols() == 1);
-      bicgstab_solve(MFsolve);
+      if (x.cols() == 1) bicgstab_solve(MFsolve);
+      else block_bicgstab_solve(block_MFsolve);
     }; break;
     case KrylovSolver::BICGSTAB: {
-      assert(x.cols() == 1);
-      bicgstab_solve([](scalar_t* x){});
+      if (x.cols() == 1) bicgstab_solve([](scalar_t* x){});
+      else block_bicgstab_solve([](DenseM_t& x){});
     }; break;
     }
 
@@ -150,6 +150,45 @@ namespace strumpack {
      const integer_t* col_ind, const scalar_t* values,
      bool symmetric_pattern) override;
 
+    /**
+     * Replace the numerical values of the matrix, keeping the
+     * reordering and symbolic factorization computed for the previous
+     * matrix. Every rank needs to provide a copy of the entire
+     * matrix, with the same sparsity pattern as before. This routine
+     * is collective on the MPI communicator from this solver.
+     *
+     * \param A input sparse matrix, should be provided on all ranks
+     * \see StrumpackSparseSolver::update_matrix_values, set_matrix
+     */
+    virtual void update_matrix_values
+    (const CSRMatrix<scalar_t,integer_t>& A) override;
+
+    /**
+     * Replace the numerical values of the matrix, keeping the
+     * reordering and symbolic factorization computed for the previous
+     * matrix. Every rank needs to provide a copy of the entire
+     * matrix, with the same sparsity pattern as before. This routine
+     * is collective on the MPI communicator from this solver.
+     *
+     * \see StrumpackSparseSolver::update_matrix_values, set_csr_matrix
+     */
+    virtual void update_matrix_values
+    (integer_t N, const integer_t* row_ptr,
+     const integer_t* col_ind, const scalar_t* values,
+     bool symmetric_pattern) override;
+
+    /**
+     * Not supported for the distributed memory solvers, returns
+     * ReturnCode::FILE_ERROR.
+     */
+    virtual ReturnCode save_factors(const std::string& filename) override;
+
+    /**
+     * Not supported for the distributed memory solvers, returns
+     * ReturnCode::FILE_ERROR.
+     */
+    virtual ReturnCode load_factors(const std::string& filename) override;
+
     /**
      * Return the MPI_Comm object associated with this solver.
      * \return MPI_Comm object for this solver.
@@ -218,6 +257,52 @@ namespace strumpack {
     this->factored_ = this->reordered_ = false;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolverMPI<scalar_t,integer_t>::update_matrix_values
+  (const CSRMatrix<scalar_t,integer_t>& A) {
+    if (!this->reordered_) {
+      set_matrix(A);
+      return;
+    }
+    mat_ = std::unique_ptr<CSRMatrix<scalar_t,integer_t>>
+      (new CSRMatrix<scalar_t,integer_t>(A));
+    this->permute_matrix_values();
+    this->factored_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolverMPI<scalar_t,integer_t>::update_matrix_values
+  (integer_t N, const integer_t* row_ptr, const integer_t* col_ind,
+   const scalar_t* values, bool symmetric_pattern) {
+    if (!this->reordered_) {
+      set_csr_matrix(N, row_ptr, col_ind, values, symmetric_pattern);
+      return;
+    }
+    mat_ = std::unique_ptr<CSRMatrix<scalar_t,integer_t>>
+      (new CSRMatrix<scalar_t,integer_t>
+       (N, row_ptr, col_ind, values, symmetric_pattern));
+    this->permute_matrix_values();
+    this->factored_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  StrumpackSparseSolverMPI<scalar_t,integer_t>::save_factors
+  (const std::string& filename) {
+    if (is_root_)
+      std::cerr << "ERROR: save_factors not supported"
+                << " for the distributed solvers" << std::endl;
+    return ReturnCode::FILE_ERROR;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  StrumpackSparseSolverMPI<scalar_t,integer_t>::load_factors
+  (const std::string& filename) {
+    if (is_root_)
+      std::cerr << "ERROR: load_factors not supported"
+                << " for the distributed solvers" << std::endl;
+    return ReturnCode::FILE_ERROR;
+  }
+
   template<typename scalar_t,typename integer_t> void
   StrumpackSparseSolverMPI<scalar_t,integer_t>::setup_tree() {
     tree_mpi_ = std::unique_ptr<EliminationTreeMPI<scalar_t,integer_t>>
@@ -279,6 +364,11 @@ namespace strumpack {
       this->fmax_ = comm_.all_reduce(df, MPI_MAX);
 #endif
     }
+#if defined(STRUMPACK_COUNT_FLOPS)
+    long long int pm = params::peak_memory;
+    this->mmin_ = comm_.all_reduce(pm, MPI_MIN);
+    this->mmax_ = comm_.all_reduce(pm, MPI_MAX);
+#endif
   }
 
   template<typename scalar_t,typename integer_t> void
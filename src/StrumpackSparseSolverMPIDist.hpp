@@ -200,6 +200,63 @@ namespace strumpack {
      const scalar_t* d_val, const integer_t* o_ptr, const integer_t* o_ind,
      const scalar_t* o_val, const integer_t* garray);
 
+    /**
+     * Replace the numerical values of the matrix, keeping the
+     * reordering and symbolic factorization computed for the previous
+     * matrix. __Only the matrix provided by the root process (in
+     * comm()) will be referenced.__ The sparsity pattern should be
+     * the same as for the previous matrix. This routine is collective
+     * on the MPI communicator from this solver.
+     *
+     * \param A input sparse matrix, should only be provided on the
+     * root process
+     * \see StrumpackSparseSolver::update_matrix_values, set_matrix
+     */
+    void update_matrix_values
+    (const CSRMatrix<scalar_t,integer_t>& A) override;
+
+    /**
+     * Replace the numerical values of the (distributed) matrix,
+     * keeping the reordering and symbolic factorization computed for
+     * the previous matrix. The sparsity pattern and the block-row
+     * distribution should be the same as for the previous
+     * matrix. This routine is collective on the MPI communicator
+     * associated with the solver.
+     *
+     * \param A input sparse matrix, should be provided on all ranks
+     * \see StrumpackSparseSolver::update_matrix_values, set_matrix
+     */
+    virtual void update_matrix_values
+    (const CSRMatrixMPI<scalar_t,integer_t>& A);
+
+    /**
+     * Replace the numerical values of the matrix, keeping the
+     * reordering and symbolic factorization computed for the previous
+     * matrix. __Only the matrix provided by the root process (in
+     * comm()) will be referenced.__ This routine is collective on the
+     * MPI communicator from this solver.
+     *
+     * \see StrumpackSparseSolver::update_matrix_values, set_csr_matrix
+     */
+    void update_matrix_values
+    (integer_t N, const integer_t* row_ptr, const integer_t* col_ind,
+     const scalar_t* values, bool symmetric_pattern=false) override;
+
+    /**
+     * Replace the numerical values of the block-row distributed CSR
+     * matrix associated with the solver, keeping the reordering and
+     * symbolic factorization computed for the previous matrix. The
+     * sparsity pattern and the block-row distribution should be the
+     * same as for the previous matrix.
+     *
+     * \see set_distributed_csr_matrix,
+     * StrumpackSparseSolver::update_matrix_values
+     */
+    void update_distributed_csr_matrix_values
+    (integer_t local_rows, const integer_t* row_ptr,
+     const integer_t* col_ind, const scalar_t* values,
+     const integer_t* dist, bool symmetric_pattern=false);
+
     /**
      * Solve a linear system with a single right-hand side. Before
      * being able to solve a linear system, the matrix needs to be
@@ -273,6 +330,7 @@ namespace strumpack {
     virtual int compute_reordering
     (int nx, int ny, int nz, int components, int width) override;
     virtual void separator_reordering() override;
+    virtual void permute_matrix_values() override;
 
   private:
     std::unique_ptr<CSRMatrixMPI<scalar_t,integer_t>> mat_mpi_;
@@ -346,6 +404,106 @@ namespace strumpack {
     this->factored_ = this->reordered_ = false;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolverMPIDist<scalar_t,integer_t>::update_matrix_values
+  (const CSRMatrix<scalar_t,integer_t>& A) {
+    if (!this->reordered_) {
+      set_matrix(A);
+      return;
+    }
+    mat_mpi_ = std::unique_ptr<CSRMatrixMPI<scalar_t,integer_t>>
+      (new CSRMatrixMPI<scalar_t,integer_t>(&A, comm_.comm(), true));
+    permute_matrix_values();
+    this->factored_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolverMPIDist<scalar_t,integer_t>::update_matrix_values
+  (const CSRMatrixMPI<scalar_t,integer_t>& A) {
+    if (!this->reordered_) {
+      set_matrix(A);
+      return;
+    }
+    mat_mpi_ = std::unique_ptr<CSRMatrixMPI<scalar_t,integer_t>>
+      (new CSRMatrixMPI<scalar_t,integer_t>(A));
+    permute_matrix_values();
+    this->factored_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolverMPIDist<scalar_t,integer_t>::update_matrix_values
+  (integer_t N, const integer_t* row_ptr, const integer_t* col_ind,
+   const scalar_t* values, bool symmetric_pattern) {
+    if (!this->reordered_) {
+      set_csr_matrix(N, row_ptr, col_ind, values, symmetric_pattern);
+      return;
+    }
+    CSRMatrix<scalar_t,integer_t> mat_seq
+      (N, row_ptr, col_ind, values, symmetric_pattern);
+    mat_mpi_ = std::unique_ptr<CSRMatrixMPI<scalar_t,integer_t>>
+      (new CSRMatrixMPI<scalar_t,integer_t>(&mat_seq, comm_.comm(), true));
+    permute_matrix_values();
+    this->factored_ = false;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolverMPIDist<scalar_t,integer_t>::
+  update_distributed_csr_matrix_values
+  (integer_t local_rows, const integer_t* row_ptr, const integer_t* col_ind,
+   const scalar_t* values, const integer_t* dist, bool symmetric_pattern) {
+    if (!this->reordered_) {
+      set_distributed_csr_matrix
+        (local_rows, row_ptr, col_ind, values, dist, symmetric_pattern);
+      return;
+    }
+    mat_mpi_ = std::unique_ptr<CSRMatrixMPI<scalar_t,integer_t>>
+      (new CSRMatrixMPI<scalar_t,integer_t>
+       (local_rows, row_ptr, col_ind, values, dist,
+        comm_.comm(), symmetric_pattern));
+    permute_matrix_values();
+    this->factored_ = false;
+  }
+
+  /**
+   * The distributed matrix is never explicitly permuted, only the
+   * matching and scaling are applied. The values are then
+   * redistributed to the proportionally mapped sparse matrix of the
+   * existing elimination tree.
+   */
+  template<typename scalar_t,typename integer_t> void
+  StrumpackSparseSolverMPIDist<scalar_t,integer_t>::permute_matrix_values() {
+    TaskTimer t("permute-matrix-values");
+    t.start();
+    if (opts_.matching() != MatchingJob::NONE) {
+      if (opts_.matching() == MatchingJob::MAX_DIAGONAL_PRODUCT_SCALING) {
+        // matching_Dc_ is local, apply_scaling needs the global Dc
+        auto P = comm_.size();
+        const auto& dist = mat_mpi_->dist();
+        std::unique_ptr<int[]> iwork(new int[2*P]);
+        auto rcnts = iwork.get();
+        auto displs = rcnts + P;
+        for (int p=0; p<P; p++) {
+          rcnts[p] = dist[p+1] - dist[p];
+          displs[p] = dist[p];
+        }
+        std::vector<scalar_t> Dc(mat_mpi_->size());
+        MPI_Allgatherv
+          (this->matching_Dc_.data(), mat_mpi_->local_rows(),
+           mpi_type<scalar_t>(), Dc.data(), rcnts, displs,
+           mpi_type<scalar_t>(), comm_.comm());
+        mat_mpi_->apply_scaling(this->matching_Dr_, Dc);
+      }
+      mat_mpi_->apply_column_permutation(this->matching_cperm_);
+      mat_mpi_->set_symm_sparse(false);
+    }
+    mat_mpi_->symmetrize_sparsity();
+    tree_mpi_dist_->update_values(opts_, *mat_mpi_);
+    t.stop();
+    if (opts_.verbose() && is_root_)
+      std::cout << "# reusing reordering and symbolic factorization,"
+                << " redistribution time = " << t.elapsed() << std::endl;
+  }
+
   template<typename scalar_t,typename integer_t> void
   StrumpackSparseSolverMPIDist<scalar_t,integer_t>::setup_reordering() {
     nd_mpi_ = std::unique_ptr<MatrixReorderingMPI<scalar_t,integer_t>>
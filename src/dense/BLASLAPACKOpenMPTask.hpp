@@ -405,6 +405,14 @@ namespace strumpack {
           (ta, n/2, n-n/2, scalar(-1.), a+n/2*lda, lda, x+(n/2)*incx, incx,
            scalar(1.), x, incx, depth);
         trsv_omp_task(ul, ta, d, n/2, a, lda, x, incx, depth);
+      } else if (ul=='L' || ul=='l') {
+        // L^T or L^H, upper triangular, solve from the bottom
+        trsv_omp_task
+          (ul, ta, d, n-n/2, a+n/2+(n/2)*lda, lda, x+(n/2)*incx, incx, depth);
+        gemv_omp_task
+          (ta, n-n/2, n/2, scalar(-1.), a+n/2, lda, x+(n/2)*incx, incx,
+           scalar(1.), x, incx, depth);
+        trsv_omp_task(ul, ta, d, n/2, a, lda, x, incx, depth);
       } else {
         std::cerr << "trsv_omp_task not implemented with this combination of"
                   << " side, uplo and transpose" << std::endl;
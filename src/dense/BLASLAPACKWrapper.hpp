@@ -46,6 +46,12 @@ namespace strumpack {
   template<class T> struct RealType { typedef T value_type; };
   template<class T> struct RealType<std::complex<T>> { typedef T value_type; };
 
+  template<class T> struct LowPrecisionType { typedef T value_type; };
+  template<> struct LowPrecisionType<double> { typedef float value_type; };
+  template<> struct LowPrecisionType<std::complex<double>> {
+    typedef std::complex<float> value_type;
+  };
+
   namespace blas {
 
     inline bool my_conj(bool a) { return a; }
@@ -413,6 +419,21 @@ namespace strumpack {
          std::complex<double>* alpha, const std::complex<double>* a, int* lda,
          std::complex<double>* b, int* ldb);
 
+      void FC_GLOBAL(ssyrk,SSYRK)
+        (char* ul, char* t, int* n, int* k, float* alpha,
+         const float* a, int* lda, float* beta, float* c, int* ldc);
+      void FC_GLOBAL(dsyrk,DSYRK)
+        (char* ul, char* t, int* n, int* k, double* alpha,
+         const double* a, int* lda, double* beta, double* c, int* ldc);
+      void FC_GLOBAL(cherk,CHERK)
+        (char* ul, char* t, int* n, int* k, float* alpha,
+         const std::complex<float>* a, int* lda, float* beta,
+         std::complex<float>* c, int* ldc);
+      void FC_GLOBAL(zherk,ZHERK)
+        (char* ul, char* t, int* n, int* k, double* alpha,
+         const std::complex<double>* a, int* lda, double* beta,
+         std::complex<double>* c, int* ldc);
+
 
       ///////////////////////////////////////////////////////////
       ///////// LAPACK //////////////////////////////////////////
@@ -1395,6 +1416,59 @@ namespace strumpack {
     }
 
 
+    template<typename scalar_t> inline long long herk_flops
+    (long long n, long long k, scalar_t alpha, scalar_t beta) {
+      return (alpha != scalar_t(0)) * n * (n + 1) * k +
+        (beta != scalar_t(0) && beta != scalar_t(1)) * n * (n + 1) / 2;
+    }
+    inline long long herk_moves(long long n, long long k) {
+      return n * n + n * k;
+    }
+    /**
+     * Symmetric (real) or Hermitian (complex) rank-k update, calls
+     * xSYRK for real and xHERK for complex scalars. Only the ul
+     * triangle of c is referenced and updated.
+     */
+    inline void herk
+    (char ul, char t, int n, int k, float alpha, const float* a, int lda,
+     float beta, float* c, int ldc) {
+      if (t == 'C' || t == 'c') t = 'T';
+      FC_GLOBAL(ssyrk,SSYRK)
+        (&ul, &t, &n, &k, &alpha, a, &lda, &beta, c, &ldc);
+      STRUMPACK_FLOPS(herk_flops(n, k, alpha, beta));
+      STRUMPACK_BYTES(4*herk_moves(n, k));
+    }
+    inline void herk
+    (char ul, char t, int n, int k, double alpha, const double* a, int lda,
+     double beta, double* c, int ldc) {
+      if (t == 'C' || t == 'c') t = 'T';
+      FC_GLOBAL(dsyrk,DSYRK)
+        (&ul, &t, &n, &k, &alpha, a, &lda, &beta, c, &ldc);
+      STRUMPACK_FLOPS(herk_flops(n, k, alpha, beta));
+      STRUMPACK_BYTES(8*herk_moves(n, k));
+    }
+    inline void herk
+    (char ul, char t, int n, int k, float alpha,
+     const std::complex<float>* a, int lda, float beta,
+     std::complex<float>* c, int ldc) {
+      if (t == 'T' || t == 't') t = 'C';
+      FC_GLOBAL(cherk,CHERK)
+        (&ul, &t, &n, &k, &alpha, a, &lda, &beta, c, &ldc);
+      STRUMPACK_FLOPS(4*herk_flops(n, k, alpha, beta));
+      STRUMPACK_BYTES(2*4*herk_moves(n, k));
+    }
+    inline void herk
+    (char ul, char t, int n, int k, double alpha,
+     const std::complex<double>* a, int lda, double beta,
+     std::complex<double>* c, int ldc) {
+      if (t == 'T' || t == 't') t = 'C';
+      FC_GLOBAL(zherk,ZHERK)
+        (&ul, &t, &n, &k, &alpha, a, &lda, &beta, c, &ldc);
+      STRUMPACK_FLOPS(4*herk_flops(n, k, alpha, beta));
+      STRUMPACK_BYTES(2*8*herk_moves(n, k));
+    }
+
+
     template<typename scalar_t> inline long long trmm_flops
     (long long m, long long n, scalar_t alpha, char s) {
       if (s=='L' || s=='l')
@@ -327,6 +327,25 @@ namespace strumpack {
     void print_to_file
     (std::string name, std::string filename, int width=8) const;
 
+    /**
+     * Write the matrix to a binary stream: the number of rows and
+     * columns (as 64 bit integers), followed by the columns.
+     *
+     * \param os Output stream, should be opened in binary mode
+     * \see read
+     */
+    void write(std::ostream& os) const;
+
+    /**
+     * Read a matrix written by write(). This matrix is resized to
+     * the size of the matrix in the stream, so this should not be
+     * called on a DenseMatrixWrapper.
+     *
+     * \param is Input stream, should be opened in binary mode
+     * \see write
+     */
+    void read(std::istream& is);
+
     /**
      * Fill the matrix with random numbers, using random number
      * generator/distribution
@@ -1223,12 +1242,15 @@ namespace strumpack {
   template<typename scalar_t> DenseMatrix<scalar_t>::DenseMatrix
   (std::size_t m, std::size_t n)
     : data_(new scalar_t[m*n]), rows_(m),
-      cols_(n), ld_(std::max(std::size_t(1), m)) { }
+      cols_(n), ld_(std::max(std::size_t(1), m)) {
+    STRUMPACK_ADD_MEMORY(rows_*cols_*sizeof(scalar_t));
+  }
 
   template<typename scalar_t> DenseMatrix<scalar_t>::DenseMatrix
   (std::size_t m, std::size_t n, const scalar_t* D, std::size_t ld)
     : data_(new scalar_t[m*n]), rows_(m), cols_(n),
       ld_(std::max(std::size_t(1), m)) {
+    STRUMPACK_ADD_MEMORY(rows_*cols_*sizeof(scalar_t));
     assert(ld >= m);
     for (std::size_t j=0; j<cols_; j++)
       for (std::size_t i=0; i<rows_; i++)
@@ -1240,6 +1262,7 @@ namespace strumpack {
    std::size_t i, std::size_t j)
     : data_(new scalar_t[m*n]), rows_(m), cols_(n),
       ld_(std::max(std::size_t(1), m)) {
+    STRUMPACK_ADD_MEMORY(rows_*cols_*sizeof(scalar_t));
     for (std::size_t _j=0; _j<std::min(cols_, D.cols()-j); _j++)
       for (std::size_t _i=0; _i<std::min(rows_, D.rows()-i); _i++)
         operator()(_i, _j) = D(_i+i, _j+j);
@@ -1249,6 +1272,7 @@ namespace strumpack {
   DenseMatrix<scalar_t>::DenseMatrix(const DenseMatrix<scalar_t>& D)
     : data_(new scalar_t[D.rows()*D.cols()]), rows_(D.rows()),
       cols_(D.cols()), ld_(std::max(std::size_t(1), D.rows())) {
+    STRUMPACK_ADD_MEMORY(rows_*cols_*sizeof(scalar_t));
     for (std::size_t j=0; j<cols_; j++)
       for (std::size_t i=0; i<rows_; i++)
         operator()(i, j) = D(i, j);
@@ -1264,6 +1288,7 @@ namespace strumpack {
   }
 
   template<typename scalar_t> DenseMatrix<scalar_t>::~DenseMatrix() {
+    if (data_) { STRUMPACK_SUB_MEMORY(rows_*cols_*sizeof(scalar_t)); }
     delete[] data_;
   }
 
@@ -1271,10 +1296,12 @@ namespace strumpack {
   DenseMatrix<scalar_t>::operator=(const DenseMatrix<scalar_t>& D) {
     if (this == &D) return *this;
     if (rows_ != D.rows() || cols_ != D.cols()) {
+      if (data_) { STRUMPACK_SUB_MEMORY(rows_*cols_*sizeof(scalar_t)); }
       rows_ = D.rows();
       cols_ = D.cols();
       delete[] data_;
       data_ = new scalar_t[rows_*cols_];
+      STRUMPACK_ADD_MEMORY(rows_*cols_*sizeof(scalar_t));
       ld_ = std::max(std::size_t(1), rows_);
     }
     for (std::size_t j=0; j<cols_; j++)
@@ -1285,6 +1312,7 @@ namespace strumpack {
 
   template<typename scalar_t> DenseMatrix<scalar_t>&
   DenseMatrix<scalar_t>::operator=(DenseMatrix<scalar_t>&& D) {
+    if (data_) { STRUMPACK_SUB_MEMORY(rows_*cols_*sizeof(scalar_t)); }
     rows_ = D.rows();
     cols_ = D.cols();
     ld_ = D.ld();
@@ -1322,23 +1350,49 @@ namespace strumpack {
     fs << "];" << std::endl << std::endl;
   }
 
+  template<typename scalar_t> void
+  DenseMatrix<scalar_t>::write(std::ostream& os) const {
+    std::uint64_t m = rows(), n = cols();
+    os.write((const char*)&m, sizeof(m));
+    os.write((const char*)&n, sizeof(n));
+    for (std::size_t j=0; j<cols(); j++)
+      os.write((const char*)ptr(0, j), sizeof(scalar_t)*rows());
+  }
+
+  template<typename scalar_t> void
+  DenseMatrix<scalar_t>::read(std::istream& is) {
+    std::uint64_t m = 0, n = 0;
+    is.read((char*)&m, sizeof(m));
+    is.read((char*)&n, sizeof(n));
+    if (!is.good()) return;
+    *this = DenseMatrix<scalar_t>(m, n);
+    for (std::size_t j=0; j<cols(); j++)
+      is.read((char*)ptr(0, j), sizeof(scalar_t)*rows());
+  }
+
   template<typename scalar_t> void
   DenseMatrix<scalar_t>::random
   (random::RandomGeneratorBase<typename RealType<scalar_t>::
    value_type>& rgen) {
     TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
-    for (std::size_t j=0; j<cols(); j++)
+    std::vector<real_t> tmp(rows());
+    for (std::size_t j=0; j<cols(); j++) {
+      rgen.generate(rows(), tmp.data());
       for (std::size_t i=0; i<rows(); i++)
-        operator()(i,j) = rgen.get();
+        operator()(i,j) = tmp[i];
+    }
     STRUMPACK_FLOPS(rgen.flops_per_prng()*cols()*rows());
   }
 
   template<typename scalar_t> void DenseMatrix<scalar_t>::random() {
     TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
     auto rgen = random::make_default_random_generator<real_t>();
-    for (std::size_t j=0; j<cols(); j++)
+    std::vector<real_t> tmp(rows());
+    for (std::size_t j=0; j<cols(); j++) {
+      rgen->generate(rows(), tmp.data());
       for (std::size_t i=0; i<rows(); i++)
-        operator()(i,j) = rgen->get();
+        operator()(i,j) = tmp[i];
+    }
     STRUMPACK_FLOPS(rgen->flops_per_prng()*cols()*rows());
   }
 
@@ -1362,6 +1416,7 @@ namespace strumpack {
   }
 
   template<typename scalar_t> void DenseMatrix<scalar_t>::clear() {
+    if (data_) { STRUMPACK_SUB_MEMORY(rows_*cols_*sizeof(scalar_t)); }
     rows_ = 0;
     cols_ = 0;
     ld_ = 1;
@@ -1372,9 +1427,11 @@ namespace strumpack {
   template<typename scalar_t> void
   DenseMatrix<scalar_t>::resize(std::size_t m, std::size_t n) {
     auto tmp = new scalar_t[m*n];
+    STRUMPACK_ADD_MEMORY(m*n*sizeof(scalar_t));
     for (std::size_t j=0; j<std::min(cols(),n); j++)
       for (std::size_t i=0; i<std::min(rows(),m); i++)
         tmp[i+j*m] = operator()(i,j);
+    if (data_) { STRUMPACK_SUB_MEMORY(rows_*cols_*sizeof(scalar_t)); }
     delete[] data_;
     data_ = tmp;
     ld_ = std::max(std::size_t(1), m);
@@ -2088,6 +2145,30 @@ namespace strumpack {
                  alpha, a.data(), a.ld(), b.data(), b.ld());
   }
 
+  /**
+   * HERK performs one of the Hermitian rank k operations
+   *
+   *    C := alpha*A*A**H + beta*C,   or   C := alpha*A**H*A + beta*C,
+   *
+   * where alpha and beta are real scalars, C is an n by n Hermitian
+   * matrix (symmetric for real scalar_t) and A is an n by k matrix in
+   * the first case and a k by n matrix in the second case. Only the
+   * ul triangular part of C is updated.
+   */
+  template<typename scalar_t> void
+  herk(UpLo ul, Trans ta, typename RealType<scalar_t>::value_type alpha,
+       const DenseMatrix<scalar_t>& a,
+       typename RealType<scalar_t>::value_type beta,
+       DenseMatrix<scalar_t>& c, int depth=0) {
+    assert(c.rows() == c.cols());
+    assert((ta==Trans::N && a.rows()==c.rows()) ||
+           (ta!=Trans::N && a.cols()==c.rows()));
+    // TODO openmp tasking ?
+    blas::herk(char(ul), char(ta), c.rows(),
+               (ta==Trans::N) ? a.cols() : a.rows(), alpha,
+               a.data(), a.ld(), beta, c.data(), c.ld());
+  }
+
   /**
    * DTRSV  solves one of the systems of equations
    *
@@ -2236,6 +2317,21 @@ namespace strumpack {
       blas::getrf_flops(a.rows(), a.cols());
   }
 
+  /** return number of flops for Cholesky factorization */
+  template<typename scalar_t> long long int
+  Cholesky_flops(const DenseMatrix<scalar_t>& a) {
+    return (is_complex<scalar_t>() ? 4:1) * blas::potrf_flops(a.rows());
+  }
+
+  /** return number of flops for a Hermitian rank-k update */
+  template<typename scalar_t> long long int
+  herk_flops(Trans ta, const DenseMatrix<scalar_t>& a,
+             const DenseMatrix<scalar_t>& c) {
+    return (is_complex<scalar_t>() ? 4:1) *
+      blas::herk_flops
+      (c.rows(), (ta==Trans::N) ? a.cols() : a.rows(), 1., 1.);
+  }
+
   /** return number of flops for solve, using LU factorization */
   template<typename scalar_t> long long int
   solve_flops(const DenseMatrix<scalar_t>& b) {
@@ -231,6 +231,7 @@ namespace strumpack {
     DenseMatrixWrapper<scalar_t> dense_wrapper();
 
     std::vector<int> LU();
+    int Cholesky();
     DistributedMatrix<scalar_t> solve
     (const DistributedMatrix<scalar_t>& b, const std::vector<int>& piv) const;
     void LQ
@@ -385,6 +386,12 @@ namespace strumpack {
        + blas::trsm_flops(rank, a.cols() - rank, scalar_t(1.), 'L'));
   }
 
+  template<typename scalar_t> long long int
+  Cholesky_flops(const DistributedMatrix<scalar_t>& a) {
+    if (!a.is_master()) return 0;
+    return (is_complex<scalar_t>() ? 4:1) * blas::potrf_flops(a.rows());
+  }
+
   template<typename scalar_t> long long int
   trsm_flops(Side s, scalar_t alpha, const DistributedMatrix<scalar_t>& a,
              const DistributedMatrix<scalar_t>& b) {
@@ -614,10 +621,12 @@ namespace strumpack {
       m.data_ = nullptr;
     } else {
       data_ = new scalar_t[lrows_*lcols_];
+      STRUMPACK_ADD_MEMORY(lrows_*lcols_*sizeof(scalar_t));
       for (int c=0; c<lcols_; c++)
         for (int r=0; r<lrows_; r++)
           operator()(r, c) = m(r, c);
     }
+    if (m.data_) { STRUMPACK_SUB_MEMORY(m.rows()*m.cols()*sizeof(scalar_t)); }
     delete[] m.data_;
     m.data_ = nullptr;
   }
@@ -634,6 +643,7 @@ namespace strumpack {
     : grid_(m.grid()), lrows_(m.lrows()), lcols_(m.lcols()) {
     std::copy(m.desc_, m.desc_+9, desc_);
     data_ = new scalar_t[lrows_*lcols_];
+    STRUMPACK_ADD_MEMORY(lrows_*lcols_*sizeof(scalar_t));
     std::copy(m.data_, m.data_+lrows_*lcols_, data_);
   }
 
@@ -665,6 +675,7 @@ namespace strumpack {
       lrows_ = scalapack::numroc(M, MB, prow(), 0, nprows());
       lcols_ = scalapack::numroc(N, NB, pcol(), 0, npcols());
       data_ = new scalar_t[lrows_*lcols_];
+      STRUMPACK_ADD_MEMORY(lrows_*lcols_*sizeof(scalar_t));
       if (scalapack::descinit
           (desc_, M, N, MB, NB, 0, 0, ctxt(), std::max(lrows_,1))) {
         std::cerr << " ERROR: Could not create DistributedMatrix descriptor!"
@@ -685,8 +696,10 @@ namespace strumpack {
       lrows_ = scalapack::numroc(desc_[2], desc_[4], prow(), desc_[6], nprows());
       lcols_ = scalapack::numroc(desc_[3], desc_[5], pcol(), desc_[7], npcols());
       assert(lrows_==desc_[8]);
-      if (lrows_ && lcols_) data_ = new scalar_t[lrows_*lcols_];
-      else data_ = nullptr;
+      if (lrows_ && lcols_) {
+        data_ = new scalar_t[lrows_*lcols_];
+        STRUMPACK_ADD_MEMORY(lrows_*lcols_*sizeof(scalar_t));
+      } else data_ = nullptr;
     }
   }
 
@@ -699,9 +712,11 @@ namespace strumpack {
   DistributedMatrix<scalar_t>::operator=
   (const DistributedMatrix<scalar_t>& m) {
     if (lrows_ != m.lrows_ || lcols_ != m.lcols_) {
+      if (data_) { STRUMPACK_SUB_MEMORY(lrows_*lcols_*sizeof(scalar_t)); }
       lrows_ = m.lrows_;  lcols_ = m.lcols_;
       delete[] data_;
       data_ = new scalar_t[lrows_*lcols_];
+      STRUMPACK_ADD_MEMORY(lrows_*lcols_*sizeof(scalar_t));
     }
     grid_ = m.grid();
     std::copy(m.data_, m.data_+lrows_*lcols_, data_);
@@ -711,6 +726,7 @@ namespace strumpack {
 
   template<typename scalar_t> DistributedMatrix<scalar_t>&
   DistributedMatrix<scalar_t>::operator=(DistributedMatrix<scalar_t>&& m) {
+    if (data_) { STRUMPACK_SUB_MEMORY(lrows_*lcols_*sizeof(scalar_t)); }
     grid_ = m.grid();
     lrows_ = m.lrows_;  lcols_ = m.lcols_;
     std::copy(m.desc_, m.desc_+9, desc_);
@@ -728,6 +744,7 @@ namespace strumpack {
   }
 
   template<typename scalar_t> void DistributedMatrix<scalar_t>::clear() {
+    if (data_) { STRUMPACK_SUB_MEMORY(lrows_*lcols_*sizeof(scalar_t)); }
     delete[] data_;
     data_ = nullptr;
     lrows_ = lcols_ = 0;
@@ -779,9 +796,12 @@ namespace strumpack {
     rgen->seed(prow(), pcol());
     int rlo, rhi, clo, chi;
     lranges(rlo, rhi, clo, chi);
-    for (int c=clo; c<chi; ++c)
+    std::vector<real_t> tmp(rhi-rlo);
+    for (int c=clo; c<chi; ++c) {
+      rgen->generate(rhi-rlo, tmp.data());
       for (int r=rlo; r<rhi; ++r)
-        operator()(r,c) = rgen->get();
+        operator()(r,c) = tmp[r-rlo];
+    }
     STRUMPACK_FLOPS(rgen->flops_per_prng()*(chi-clo)*(rhi-rlo));
   }
 
@@ -792,9 +812,12 @@ namespace strumpack {
     TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
     int rlo, rhi, clo, chi;
     lranges(rlo, rhi, clo, chi);
-    for (int c=clo; c<chi; ++c)
+    std::vector<real_t> tmp(rhi-rlo);
+    for (int c=clo; c<chi; ++c) {
+      rgen.generate(rhi-rlo, tmp.data());
       for (int r=rlo; r<rhi; ++r)
-        operator()(r,c) = rgen.get();
+        operator()(r,c) = tmp[r-rlo];
+    }
     STRUMPACK_FLOPS(rgen.flops_per_prng()*(chi-clo)*(rhi-rlo));
   }
 
@@ -1204,6 +1227,20 @@ namespace strumpack {
     return ipiv;
   }
 
+  // Cholesky factorization, only the lower triangular part is
+  // referenced and overwritten with L, such that A = L L^H.
+  template<typename scalar_t> int
+  DistributedMatrix<scalar_t>::Cholesky() {
+    if (!active()) return 0;
+    assert(rows() == cols());
+    STRUMPACK_FLOPS(Cholesky_flops(*this));
+    int info = scalapack::ppotrf('L', rows(), data(), I(), J(), desc());
+    if (info)
+      std::cerr << "ERROR: Cholesky factorization of DistributedMatrix"
+                << " failed with info = " << info << std::endl;
+    return info;
+  }
+
   // Solve a system of linear equations with B as right hand side.
   // assumption: the current matrix should have been factored using LU.
   template<typename scalar_t> DistributedMatrix<scalar_t>
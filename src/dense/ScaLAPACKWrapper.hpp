@@ -426,6 +426,17 @@ namespace strumpack {
         (int *, int *, std::complex<double> *, int *, int *, const int *,
          int *, int *);
 
+      void FC_GLOBAL(pspotrf,PSPOTRF)
+        (char *, int *, float *, int *, int *, const int *, int *);
+      void FC_GLOBAL(pdpotrf,PDPOTRF)
+        (char *, int *, double *, int *, int *, const int *, int *);
+      void FC_GLOBAL(pcpotrf,PCPOTRF)
+        (char *, int *, std::complex<float> *, int *, int *,
+         const int *, int *);
+      void FC_GLOBAL(pzpotrf,PZPOTRF)
+        (char *, int *, std::complex<double> *, int *, int *,
+         const int *, int *);
+
       void FC_GLOBAL(psgetrs,PSGETRS)
         (char *, int *, int *, const float *, int *, int *, const int *,
          const int *, float *, int *, int *, const int *, int *);
@@ -1280,6 +1291,33 @@ namespace strumpack {
       return info;
     }
 
+    inline int ppotrf
+    (char ul, int n, float* a, int ia, int ja, const int *desca) {
+      int info;
+      FC_GLOBAL(pspotrf,PSPOTRF)(&ul, &n, a, &ia, &ja, desca, &info);
+      return info;
+    }
+    inline int ppotrf
+    (char ul, int n, double* a, int ia, int ja, const int *desca) {
+      int info;
+      FC_GLOBAL(pdpotrf,PDPOTRF)(&ul, &n, a, &ia, &ja, desca, &info);
+      return info;
+    }
+    inline int ppotrf
+    (char ul, int n, std::complex<float>* a, int ia, int ja,
+     const int *desca) {
+      int info;
+      FC_GLOBAL(pcpotrf,PCPOTRF)(&ul, &n, a, &ia, &ja, desca, &info);
+      return info;
+    }
+    inline int ppotrf
+    (char ul, int n, std::complex<double>* a, int ia, int ja,
+     const int *desca) {
+      int info;
+      FC_GLOBAL(pzpotrf,PZPOTRF)(&ul, &n, a, &ia, &ja, desca, &info);
+      return info;
+    }
+
     inline int pgetrs
     (char trans, int m, int n,
      const float* a, int ia, int ja, const int *desca, const int *ipiv,
@@ -38,6 +38,7 @@
 
 #include "Metrics.hpp"
 #include "HSS/HSSOptions.hpp"
+#include "HSS/HSSPartitionTree.hpp"
 #include "dense/DenseMatrix.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "dense/DistributedMatrix.hpp"
@@ -73,6 +74,7 @@ namespace strumpack {
     template<typename scalar_t> class Kernel {
       using DenseM_t = DenseMatrix<scalar_t>;
       using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+      using real_t = typename RealType<scalar_t>::value_type;
 #if defined(STRUMPACK_USE_MPI)
       using DistM_t = DistributedMatrix<scalar_t>;
 #endif
@@ -138,11 +140,7 @@ namespace strumpack {
                       const std::vector<std::size_t>& J,
                       DenseM_t& B) const {
         assert(B.rows() == I.size() && B.cols() == J.size());
-        for (std::size_t j=0; j<J.size(); j++)
-          for (std::size_t i=0; i<I.size(); i++) {
-            assert(I[i] < n() && J[j] < n());
-            B(i, j) = eval(I[i], J[j]);
-          }
+        eval_submatrix(I, J, B);
       }
 
       /**
@@ -180,6 +178,34 @@ namespace strumpack {
       std::vector<scalar_t> predict
       (const DenseM_t& test, const DenseM_t& weights) const;
 
+      /**
+       * Return approximate prediction scores for the test points,
+       * using the weights computed in fit_HSS() or fit_HODLR(). This
+       * is a treecode: the test points are clustered, and for each
+       * leaf of test points, the cluster tree of the training points
+       * (see tree()) is traversed. Blocks of the kernel matrix for
+       * well separated clusters are approximated using adaptive
+       * cross approximation, the others are evaluated exactly. If
+       * tree() does not match the training data, a kd-tree is built
+       * on a copy of the data.
+       *
+       * \param test Test data set, should be test.rows() == this->d()
+       * \param weights Weights computed by fit_HSS() or fit_HODLR()
+       * \param tol Relative tolerance for the low-rank
+       * approximations.
+       * \param eta Admissibility parameter, a test cluster and a
+       * training cluster are considered well separated when the sum
+       * of their radii is smaller than eta times the distance
+       * between their centers.
+       * \param leaf_size Leaf size for the clustering of the test
+       * points (and of the training points if tree() is not set).
+       * eturn Vector with prediction scores.
+       * \see predict, tree
+       */
+      std::vector<scalar_t> predict_treecode
+      (const DenseM_t& test, const DenseM_t& weights,
+       real_t tol=1e-6, real_t eta=1., std::size_t leaf_size=128) const;
+
 #if defined(STRUMPACK_USE_MPI)
       /**
        * Compute weights for kernel ridge regression
@@ -261,12 +287,21 @@ namespace strumpack {
       std::vector<int>& permutation() { return perm_; }
       const std::vector<int>& permutation() const { return perm_; }
 
+      /**
+       * Cluster tree of the (permuted) data points. This is set by
+       * the clustering in the HSS/HODLR constructors, and is used by
+       * predict_treecode().
+       */
+      HSS::HSSPartitionTree& tree() { return tree_; }
+      const HSS::HSSPartitionTree& tree() const { return tree_; }
+
       virtual void permute() {}
 
     protected:
       DenseM_t& data_;
       scalar_t lambda_;
       std::vector<int> perm_;
+      HSS::HSSPartitionTree tree_;
 
       /**
        * Purely virtual function that needs to be defined in the
@@ -284,6 +319,59 @@ namespace strumpack {
        */
       virtual scalar_t eval_kernel_function
       (const scalar_t* x, const scalar_t* y) const = 0;
+
+      /**
+       * Evaluate the kernel function, without the regularization
+       * parameter, for all pairs of columns of X and Y: K(i,j) =
+       * k(X(:,i), Y(:,j)). X and Y have d() rows, K should be
+       * X.cols() x Y.cols(). This is used for prediction and for
+       * extracting submatrices of the kernel matrix. The default
+       * calls eval_kernel_function for every pair, subclasses can
+       * override this with a blocked implementation.
+       *
+       * \see GaussKernel::eval_kernel_block,
+       * LaplaceKernel::eval_kernel_block
+       */
+      virtual void eval_kernel_block
+      (const DenseM_t& X, const DenseM_t& Y, DenseM_t& K) const {
+        for (std::size_t j=0; j<Y.cols(); j++)
+          for (std::size_t i=0; i<X.cols(); i++)
+            K(i, j) = eval_kernel_function(X.ptr(0, i), Y.ptr(0, j));
+      }
+
+      /**
+       * Set B = K(I,J). This copies the data points I and J and then
+       * calls eval_kernel_block. Subclasses which override eval()
+       * should also override this.
+       */
+      virtual void eval_submatrix
+      (const std::vector<std::size_t>& I, const std::vector<std::size_t>& J,
+       DenseM_t& B) const {
+        DenseM_t XI(d(), I.size()), XJ(d(), J.size());
+        for (std::size_t i=0; i<I.size(); i++) {
+          assert(I[i] < n());
+          std::copy(data_.ptr(0, I[i]), data_.ptr(0, I[i])+d(), XI.ptr(0, i));
+        }
+        for (std::size_t j=0; j<J.size(); j++) {
+          assert(J[j] < n());
+          std::copy(data_.ptr(0, J[j]), data_.ptr(0, J[j])+d(), XJ.ptr(0, j));
+        }
+        eval_kernel_block(XI, XJ, B);
+        if (lambda_ != scalar_t(0.))
+          for (std::size_t j=0; j<J.size(); j++)
+            for (std::size_t i=0; i<I.size(); i++)
+              if (I[i] == J[j]) B(i, j) += lambda_;
+      }
+
+      /**
+       * Add K(X, test)^T w to prediction, where X are training
+       * points, with weights w. The test and training points are
+       * handled in blocks, in parallel over the blocks of test
+       * points.
+       */
+      void predict_blocked
+      (const DenseM_t& X, const scalar_t* w, const DenseM_t& test,
+       std::vector<scalar_t>& prediction) const;
     };
 
 
@@ -329,6 +417,37 @@ namespace strumpack {
           (-Euclidean_distance_squared(this->d(), x, y)
            / (scalar_t(2.) * h_ * h_));
       }
+
+      /**
+       * Computes the squared distances as ||x||^2 + ||y||^2 - 2 x^T
+       * y, with the inner products from a single gemm, followed by
+       * the exponential of all entries. Differences smaller than the
+       * rounding error on ||x||^2 are lost, which only affects
+       * kernel values close to 1.
+       */
+      void eval_kernel_block
+      (const DenseMatrix<scalar_t>& X, const DenseMatrix<scalar_t>& Y,
+       DenseMatrix<scalar_t>& K) const override {
+        const std::size_t m = X.cols(), n = Y.cols(), d = this->d();
+        if (!m || !n) return;
+        std::vector<scalar_t> nx(m), ny(n);
+        auto sqnorm = [d](const scalar_t* x) {
+          scalar_t k(0.);
+          for (std::size_t l=0; l<d; l++) k += x[l] * x[l];
+          return k;
+        };
+        for (std::size_t i=0; i<m; i++) nx[i] = sqnorm(X.ptr(0, i));
+        for (std::size_t j=0; j<n; j++) ny[j] = sqnorm(Y.ptr(0, j));
+        blas::gemm('T', 'N', m, n, d, scalar_t(-2.), X.data(), X.ld(),
+                   Y.data(), Y.ld(), scalar_t(0.), K.data(), K.ld());
+        const scalar_t s = scalar_t(-1.) / (scalar_t(2.) * h_ * h_);
+        for (std::size_t j=0; j<n; j++) {
+          auto Kj = K.ptr(0, j);
+          for (std::size_t i=0; i<m; i++)
+            Kj[i] = std::exp
+              (std::max(scalar_t(0.), Kj[i] + nx[i] + ny[j]) * s);
+        }
+      }
     };
 
 
@@ -372,6 +491,27 @@ namespace strumpack {
       (const scalar_t* x, const scalar_t* y) const override {
         return std::exp(-norm1_distance(this->d(), x, y) / h_);
       }
+
+      /**
+       * The 1-norm distance cannot be computed with a gemm, so this
+       * loops over blocks of columns of X, which stay in cache while
+       * the columns of Y are visited.
+       */
+      void eval_kernel_block
+      (const DenseMatrix<scalar_t>& X, const DenseMatrix<scalar_t>& Y,
+       DenseMatrix<scalar_t>& K) const override {
+        const std::size_t m = X.cols(), n = Y.cols(), d = this->d();
+        const std::size_t B = std::max(std::size_t(1), 4096 / (d+1));
+        const scalar_t s = scalar_t(-1.) / h_;
+        for (std::size_t i0=0; i0<m; i0+=B) {
+          const auto i1 = std::min(m, i0+B);
+          for (std::size_t j=0; j<n; j++) {
+            auto y = Y.ptr(0, j);
+            for (std::size_t i=i0; i<i1; i++)
+              K(i, j) = std::exp(norm1_distance(d, X.ptr(0, i), y) * s);
+          }
+        }
+      }
     };
 
     /**
@@ -426,7 +566,7 @@ namespace strumpack {
         for (int j=0; j<p_; j++) Kss[j] = 0;
         for (int i=0; i<this->d(); i++) {
           scalar_t tmp = std::exp
-            (-Euclidean_distance_squared(this->d(), &x[i], &y[i])
+            (-Euclidean_distance_squared(1, &x[i], &y[i])
              / (scalar_t(2.) * h_ * h_));
           Ks[0] = tmp;
           Kss[0] += Ks[0];
@@ -486,6 +626,14 @@ namespace strumpack {
     protected:
       DenseMatrix<scalar_t>& A_; // kernel matrix
 
+      void eval_submatrix
+      (const std::vector<std::size_t>& I, const std::vector<std::size_t>& J,
+       DenseMatrix<scalar_t>& B) const override {
+        for (std::size_t j=0; j<J.size(); j++)
+          for (std::size_t i=0; i<I.size(); i++)
+            B(i, j) = eval(I[i], J[j]);
+      }
+
       scalar_t eval_kernel_function
       (const scalar_t* x, const scalar_t* y) const override {
         assert(false);
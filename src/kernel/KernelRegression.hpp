@@ -38,6 +38,8 @@
 
 #include "Kernel.hpp"
 #include "HSS/HSSMatrix.hpp"
+#include "clustering/Clustering.hpp"
+#include "dense/ACA.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "HSS/HSSMatrixMPI.hpp"
 #if defined(STRUMPACK_USE_BPACK)
@@ -113,11 +115,188 @@ namespace strumpack {
     (const DenseM_t& test, const DenseM_t& weights) const {
       assert(test.rows() == d());
       std::vector<scalar_t> prediction(test.cols());
-#pragma omp parallel for
-      for (std::size_t c=0; c<test.cols(); c++)
-        for (std::size_t r=0; r<n(); r++)
-          prediction[c] += weights(r, 0) *
-            eval_kernel_function(data_.ptr(0, r), test.ptr(0, c));
+      predict_blocked(data_, weights.data(), test, prediction);
+      return prediction;
+    }
+
+    template<typename scalar_t> void
+    Kernel<scalar_t>::predict_blocked
+    (const DenseM_t& X, const scalar_t* w, const DenseM_t& test,
+     std::vector<scalar_t>& prediction) const {
+      // blocks of B test points, times blocks of B training points
+      const std::size_t B = 256, nt = test.cols(), n = X.cols();
+      if (!nt || !n) return;
+#pragma omp parallel
+      {
+        DenseM_t K(std::min(B, n), std::min(B, nt));
+#pragma omp for schedule(dynamic)
+        for (std::size_t c0=0; c0<nt; c0+=B) {
+          const auto nc = std::min(B, nt-c0);
+          auto T = ConstDenseMatrixWrapperPtr(d(), nc, test, 0, c0);
+          for (std::size_t r0=0; r0<n; r0+=B) {
+            const auto nr = std::min(B, n-r0);
+            auto Xr = ConstDenseMatrixWrapperPtr(d(), nr, X, 0, r0);
+            DenseMW_t Kb(nr, nc, K, 0, 0);
+            eval_kernel_block(*Xr, *T, Kb);
+            blas::gemv('T', nr, nc, scalar_t(1.), Kb.data(), Kb.ld(),
+                       w+r0, 1, scalar_t(1.), prediction.data()+c0, 1);
+          }
+        }
+      }
+    }
+
+    /**
+     * Node of a cluster tree, with the range [lo,hi) of the
+     * (permuted) points in the cluster, and the center and radius of
+     * a ball containing all the points in the cluster.
+     */
+    template<typename scalar_t> struct ClusterBall {
+      using real_t = typename RealType<scalar_t>::value_type;
+      std::size_t lo, hi;
+      int c0 = -1, c1 = -1;  // children, -1 for a leaf
+      std::vector<scalar_t> center;
+      real_t radius = 0;
+      bool leaf() const { return c0 < 0; }
+    };
+
+    /**
+     * Add the nodes of tree t (and its descendants), with the points
+     * starting at column lo of X, to balls. The root of t is added
+     * first, its index is returned.
+     */
+    template<typename scalar_t> int cluster_balls
+    (const HSS::HSSPartitionTree& t, const DenseMatrix<scalar_t>& X,
+     std::size_t lo, std::vector<ClusterBall<scalar_t>>& balls) {
+      const std::size_t d = X.rows(), hi = lo + t.size;
+      int id = balls.size();
+      balls.emplace_back();
+      if (!t.c.empty()) {
+        auto c0 = cluster_balls(t.c[0], X, lo, balls);
+        auto c1 = cluster_balls(t.c[1], X, lo+t.c[0].size, balls);
+        balls[id].c0 = c0;
+        balls[id].c1 = c1;
+      }
+      auto& b = balls[id];
+      b.lo = lo;
+      b.hi = hi;
+      b.center.assign(d, scalar_t(0.));
+      for (std::size_t i=lo; i<hi; i++)
+        for (std::size_t k=0; k<d; k++)
+          b.center[k] += X(k, i);
+      if (hi > lo)
+        for (auto& c : b.center) c /= scalar_t(hi - lo);
+      for (std::size_t i=lo; i<hi; i++)
+        b.radius = std::max
+          (b.radius, Euclidean_distance(d, b.center.data(), X.ptr(0, i)));
+      return id;
+    }
+
+    template<typename scalar_t> std::vector<scalar_t>
+    Kernel<scalar_t>::predict_treecode
+    (const DenseM_t& test, const DenseM_t& weights,
+     real_t tol, real_t eta, std::size_t leaf_size) const {
+      assert(test.rows() == d());
+      const std::size_t nt = test.cols();
+      std::vector<scalar_t> prediction(nt);
+      if (!nt || !n()) return prediction;
+      // training points and weights, in the order of the tree
+      const DenseM_t* X = &data_;
+      const scalar_t* w = weights.data();
+      const HSS::HSSPartitionTree* stree = &tree_;
+      DenseM_t Xc;
+      std::vector<scalar_t> wc;
+      HSS::HSSPartitionTree Xtree;
+      if (tree_.size != int(n())) {
+        Xc = data_;
+        std::vector<int> perm;
+        Xtree = binary_tree_clustering
+          (ClusteringAlgorithm::KD_TREE, Xc, perm, leaf_size);
+        wc.resize(n());
+        for (std::size_t i=0; i<n(); i++)
+          wc[i] = weights(perm[i]-1, 0);
+        X = &Xc;
+        w = wc.data();
+        stree = &Xtree;
+      }
+      std::vector<ClusterBall<scalar_t>> S, T;
+      cluster_balls(*stree, *X, 0, S);
+      DenseM_t Y(test);
+      std::vector<int> tperm;
+      auto ttree = binary_tree_clustering
+        (ClusteringAlgorithm::KD_TREE, Y, tperm, leaf_size);
+      cluster_balls(ttree, Y, 0, T);
+      std::vector<scalar_t> pred(nt);
+      const auto atol = blas::lamch<real_t>('S');
+      // Add the contribution of training cluster s to the test
+      // points in cluster t, with a dual tree traversal. When t is
+      // split, its children are handled in separate tasks, they
+      // write to different parts of pred.
+      std::function<void(int,int,int)> interact =
+        [&](int ti, int si, int depth) {
+        const auto& t = T[ti];
+        const auto& s = S[si];
+        const std::size_t m = t.hi - t.lo, ns = s.hi - s.lo;
+        if (!m || !ns) return;
+        auto Yt = ConstDenseMatrixWrapperPtr(d(), m, Y, 0, t.lo);
+        auto Xs = ConstDenseMatrixWrapperPtr(d(), ns, *X, 0, s.lo);
+        if (t.radius + s.radius <= eta * Euclidean_distance
+            (d(), t.center.data(), s.center.data())) {
+          // only use the low-rank form if cheaper than dense
+          int max_rank = m * ns / (m + ns);
+          if (max_rank > 0) {
+            auto Arow = [&](std::size_t i, scalar_t* B) {
+              DenseMW_t Kr(ns, 1, B, ns);
+              eval_kernel_block
+                (*Xs, *ConstDenseMatrixWrapperPtr(d(), 1, *Yt, 0, i), Kr);
+            };
+            auto Acol = [&](std::size_t j, scalar_t* B) {
+              DenseMW_t Kc(m, 1, B, m);
+              eval_kernel_block
+                (*Yt, *ConstDenseMatrixWrapperPtr(d(), 1, *Xs, 0, j), Kc);
+            };
+            DenseM_t U, V;
+            adaptive_cross_approximation<scalar_t>
+              (U, V, m, ns, Arow, Acol, tol, atol, max_rank,
+               params::task_recursion_cutoff_level);
+            const int r = U.cols();
+            if (r < max_rank) {
+              if (r) {
+                std::vector<scalar_t> Vw(r);
+                blas::gemv('N', r, ns, scalar_t(1.), V.data(), V.ld(),
+                           w+s.lo, 1, scalar_t(0.), Vw.data(), 1);
+                blas::gemv('N', m, r, scalar_t(1.), U.data(), U.ld(),
+                           Vw.data(), 1, scalar_t(1.), &pred[t.lo], 1);
+              }
+              return;
+            }
+          }
+        }
+        if (!t.leaf() && (s.leaf() || t.radius >= s.radius)) {
+          if (depth < params::task_recursion_cutoff_level) {
+#pragma omp task default(shared)
+            interact(t.c0, si, depth+1);
+#pragma omp task default(shared)
+            interact(t.c1, si, depth+1);
+#pragma omp taskwait
+          } else {
+            interact(t.c0, si, depth+1);
+            interact(t.c1, si, depth+1);
+          }
+        } else if (!s.leaf()) {
+          interact(ti, s.c0, depth);
+          interact(ti, s.c1, depth);
+        } else {
+          DenseM_t K(ns, m);
+          eval_kernel_block(*Xs, *Yt, K);
+          blas::gemv('T', ns, m, scalar_t(1.), K.data(), K.ld(),
+                     w+s.lo, 1, scalar_t(1.), &pred[t.lo], 1);
+        }
+      };
+#pragma omp parallel
+#pragma omp single nowait
+      interact(0, 0, 0);
+      for (std::size_t i=0; i<nt; i++)
+        prediction[tperm[i]-1] = pred[i];
       return prediction;
     }
 
@@ -193,13 +372,16 @@ namespace strumpack {
     (const DenseM_t& test, const DistM_t& weights) const {
       std::vector<scalar_t> prediction(test.cols());
       if (weights.active() && weights.lcols()) {
-#pragma omp parallel for
-        for (std::size_t c=0; c<test.cols(); c++)
-          for (std::size_t r=0; r<weights.lrows(); r++) {
-            prediction[c] += weights(r, 0) *
-              eval_kernel_function
-              (data_.ptr(0, weights.rowl2g(r)), test.ptr(0, c));
-          }
+        // gather the training points for the local rows of weights
+        const std::size_t lr = weights.lrows();
+        DenseM_t X(d(), lr);
+        std::vector<scalar_t> w(lr);
+        for (std::size_t r=0; r<lr; r++) {
+          auto g = weights.rowl2g(r);
+          std::copy(data_.ptr(0, g), data_.ptr(0, g)+d(), X.ptr(0, r));
+          w[r] = weights(r, 0);
+        }
+        predict_blocked(X, w.data(), test, prediction);
       }
       // reduce the local sums to the global vector
       weights.Comm().all_reduce
@@ -0,0 +1,116 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*!
+ * \file MappedFile.hpp
+ * \brief Contains a read-only memory mapped file, used for fast
+ * (multithreaded) reading of large matrix files.
+ */
+#ifndef STRUMPACK_MAPPED_FILE_HPP
+#define STRUMPACK_MAPPED_FILE_HPP
+
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace strumpack {
+
+  /**
+   * \class MappedFile
+   *
+   * \brief Read-only memory map of an entire file.
+   *
+   * The file is mapped on construction and unmapped on
+   * destruction. Pages are only read from disk when they are
+   * touched, so different threads (or processes) can each parse a
+   * different part of the file without first reading it into a
+   * buffer.
+   */
+  class MappedFile {
+  public:
+    /**
+     * Map the file with the given name. Check good() to see if this
+     * succeeded.
+     */
+    MappedFile(const std::string& filename) {
+      fd_ = ::open(filename.c_str(), O_RDONLY);
+      if (fd_ == -1) return;
+      struct stat st;
+      if (::fstat(fd_, &st) == -1 || st.st_size == 0) return;
+      size_ = st.st_size;
+      void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+      if (p == MAP_FAILED) { size_ = 0; return; }
+      ::madvise(p, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(p);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+      if (data_) ::munmap(const_cast<char*>(data_), size_);
+      if (fd_ != -1) ::close(fd_);
+    }
+
+    /** Whether the file was opened and mapped successfully. */
+    bool good() const { return data_ != nullptr; }
+    /** Size of the file, in bytes. */
+    std::size_t size() const { return size_; }
+    /** Pointer to the first byte of the file. */
+    const char* data() const { return data_; }
+    /** Pointer one past the last byte of the file. */
+    const char* end() const { return data_ + size_; }
+
+  private:
+    int fd_ = -1;
+    std::size_t size_ = 0;
+    const char* data_ = nullptr;
+  };
+
+  /**
+   * Copy bytes bytes from src to dst, using multiple threads. This
+   * is used to copy large arrays out of a MappedFile, where the
+   * copy is limited by page faults rather than memory bandwidth.
+   */
+  inline void parallel_copy(void* dst, const void* src, std::size_t bytes) {
+    const std::size_t B = 1 << 22;
+    const auto nb = static_cast<long long>((bytes + B - 1) / B);
+#pragma omp parallel for schedule(dynamic)
+    for (long long b=0; b<nb; b++) {
+      std::size_t lo = b * B;
+      std::memcpy(static_cast<char*>(dst) + lo,
+                  static_cast<const char*>(src) + lo,
+                  std::min(B, bytes - lo));
+    }
+  }
+
+} // end namespace strumpack
+
+#endif // STRUMPACK_MAPPED_FILE_HPP
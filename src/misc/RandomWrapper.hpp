@@ -36,6 +36,9 @@
 #include <memory>
 #include <random>
 #include <iostream>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
 
 namespace strumpack {
 
@@ -51,7 +54,9 @@ namespace strumpack {
      */
     enum class RandomEngine {
       LINEAR,   /*!< The C++11 std::minstd_rand random number generator. */
-      MERSENNE  /*!< The C++11 std::mt19937 random number generator.     */
+      MERSENNE, /*!< The C++11 std::mt19937 random number generator.     */
+      PHILOX    /*!< Counter based Philox4x32-10 generator, element
+                  (i,j) is computed directly, without reseeding. */
     };
 
     /**
@@ -63,6 +68,7 @@ namespace strumpack {
       switch (e) {
       case RandomEngine::LINEAR: return "minstd_rand"; break;
       case RandomEngine::MERSENNE: return "mt19937"; break;
+      case RandomEngine::PHILOX: return "philox4x32-10"; break;
       }
       return "unknown";
     }
@@ -111,6 +117,14 @@ namespace strumpack {
       virtual real_t get() = 0;
       virtual real_t get(std::uint32_t i, std::uint32_t j) = 0;
       virtual int flops_per_prng() = 0;
+
+      /**
+       * Fill x with the next n random numbers, this is the same as
+       * calling get() n times.
+       */
+      virtual void generate(std::size_t n, real_t* x) {
+        for (std::size_t i=0; i<n; i++) x[i] = get();
+      }
     };
 
     /**
@@ -190,6 +204,133 @@ namespace strumpack {
       D d;
     };
 
+    /**
+     * \class PhiloxRandomGenerator
+     * \brief Counter based random number generator
+     *
+     * Philox4x32-10, from Salmon et al., "Parallel random numbers: as
+     * easy as 1, 2, 3", SC'11. The 128 bit counter (i, j, k, 0) is
+     * encrypted with a 64 bit key (the seed), so the k-th number of
+     * the stream for point (i,j) is computed directly, without any
+     * state. This makes seed(i,j) and get(i,j) cheap and the
+     * generation of a block of numbers easy to vectorize. Each
+     * counter gives 128 random bits, which are turned into 2 uniform
+     * or 2 normal (Box-Muller) numbers.
+     *
+     * \tparam real_t float or double
+     * \tparam D random distribution
+     */
+    template<typename real_t, RandomDistribution D>
+    class PhiloxRandomGenerator : public RandomGeneratorBase<real_t> {
+    public:
+      PhiloxRandomGenerator() { seed(0); }
+      PhiloxRandomGenerator(std::size_t s) { seed(s); }
+
+      void seed(std::size_t s) {
+        key_[0] = std::uint32_t(s);
+        key_[1] = std::uint32_t(std::uint64_t(s) >> 32);
+        set_counter(0, 0);
+      }
+      void seed(std::seed_seq& s) {
+        s.generate(key_, key_+2);
+        set_counter(0, 0);
+      }
+      void seed(std::uint32_t i, std::uint32_t j) { set_counter(i, j); }
+
+      real_t get() {
+        if (nbuf_ == 0) {
+          block(ctr_[0], ctr_[1], ctr_[2]++, buf_);
+          nbuf_ = 2;
+        }
+        return buf_[2-nbuf_--];
+      }
+
+      real_t get(std::uint32_t i, std::uint32_t j) {
+        set_counter(i, j);
+        return get();
+      }
+
+      void generate(std::size_t n, real_t* x) {
+        std::size_t i = 0;
+        for (; i<n && nbuf_; i++) x[i] = get();
+        const std::size_t B = 16;
+        std::uint32_t c[B], r[4][B];
+        for (; i+2*B<=n; i+=2*B) {
+          for (std::size_t b=0; b<B; b++) c[b] = ctr_[2] + b;
+          philox(ctr_[0], ctr_[1], c, r, B);
+          for (std::size_t b=0; b<B; b++)
+            transform(r[0][b], r[1][b], r[2][b], r[3][b], x+i+2*b);
+          ctr_[2] += B;
+        }
+        for (; i<n; i++) x[i] = get();
+      }
+
+      int flops_per_prng() {
+        return (D == RandomDistribution::NORMAL) ? 12 : 2;
+      }
+
+    private:
+      std::uint32_t key_[2], ctr_[3];
+      real_t buf_[2];
+      int nbuf_ = 0;
+
+      void set_counter(std::uint32_t i, std::uint32_t j) {
+        ctr_[0] = i; ctr_[1] = j; ctr_[2] = 0;
+        nbuf_ = 0;
+      }
+
+      void block(std::uint32_t i, std::uint32_t j, std::uint32_t k,
+                 real_t* x) const {
+        std::uint32_t r[4][1];
+        philox(i, j, &k, r, 1);
+        transform(r[0][0], r[1][0], r[2][0], r[3][0], x);
+      }
+
+      // 10 Philox rounds on B counters (i, j, k[b], 0), lanes are
+      // independent so the inner loops vectorize
+      template<std::size_t B> void philox
+      (std::uint32_t i, std::uint32_t j, const std::uint32_t* k,
+       std::uint32_t (&r)[4][B], std::size_t nb) const {
+        const std::uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        std::uint32_t k0 = key_[0], k1 = key_[1];
+        for (std::size_t b=0; b<nb; b++) {
+          r[0][b] = i; r[1][b] = j; r[2][b] = k[b]; r[3][b] = 0;
+        }
+        for (int round=0; round<10; round++) {
+          for (std::size_t b=0; b<nb; b++) {
+            std::uint64_t p0 = M0 * r[0][b], p1 = M1 * r[2][b];
+            std::uint32_t x0 = std::uint32_t(p1 >> 32) ^ r[1][b] ^ k0;
+            std::uint32_t x2 = std::uint32_t(p0 >> 32) ^ r[3][b] ^ k1;
+            r[1][b] = std::uint32_t(p1);
+            r[3][b] = std::uint32_t(p0);
+            r[0][b] = x0;
+            r[2][b] = x2;
+          }
+          k0 += 0x9E3779B9;
+          k1 += 0xBB67AE85;
+        }
+      }
+
+      // 4 x 32 random bits to 2 numbers
+      static void transform
+      (std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d,
+       real_t* x) {
+        // uniform in (0,1], 53 bits
+        const double s = 1. / 9007199254740992.;
+        double u0 = ((((std::uint64_t(a) << 32) | b) >> 11) + 1) * s;
+        double u1 = ((((std::uint64_t(c) << 32) | d) >> 11) + 1) * s;
+        if (D == RandomDistribution::NORMAL) {
+          const double twopi = 6.283185307179586;
+          double rho = std::sqrt(-2. * std::log(u0));
+          x[0] = real_t(rho * std::cos(twopi * u1));
+          x[1] = real_t(rho * std::sin(twopi * u1));
+        } else {
+          x[0] = real_t(u0);
+          x[1] = real_t(u1);
+        }
+      }
+    };
+
     /**
      * Factory method to construct a RandomGeneratorBase with a
      * specified random engine and random distribution, with seed s.
@@ -221,6 +362,15 @@ namespace strumpack {
           return std::unique_ptr<RandomGeneratorBase<real_t>>
             (new RandomGenerator<real_t,std::mt19937,
              std::uniform_real_distribution<real_t>>(seed));
+      } else if (e == RandomEngine::PHILOX) {
+        if (d == RandomDistribution::NORMAL)
+          return std::unique_ptr<RandomGeneratorBase<real_t>>
+            (new PhiloxRandomGenerator
+             <real_t,RandomDistribution::NORMAL>(seed));
+        else if (d == RandomDistribution::UNIFORM)
+          return std::unique_ptr<RandomGeneratorBase<real_t>>
+            (new PhiloxRandomGenerator
+             <real_t,RandomDistribution::UNIFORM>(seed));
       }
       return NULL;
     }
@@ -30,6 +30,9 @@
 #include <iomanip>
 #include <fstream>
 #include <cassert>
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #if defined(_OPENMP)
 #include <omp.h>
 #endif
@@ -151,6 +154,8 @@ void TaskTimer::print_name(std::ostream& os) {
     case TaskType::COMPUTE_SAMPLES:       os << "COMPUTE_SAMPLES"; break;
     case TaskType::ORTHO:                 os << "ORTHO"; break;
     case TaskType::REDIST_2D_TO_HSS:      os << "REDIST_2D_TO_HSS"; break;
+    case TaskType::BUILD_FRONT:           os << "BUILD_FRONT"; break;
+    case TaskType::FACTOR_FRONT:          os << "FACTOR_FRONT"; break;
     default: os << "SOMEOTHERTAKSNOTNAMED";
     }
   }
@@ -214,6 +219,116 @@ void TaskTimer::stop() {
   t_stop = GET_TIME_NOW();
   stopped = true;
   time_log_list.list[tid].push_back(*this);
+  if (started && TraceLog::enabled() &&
+      type != TaskType::EXPLICITLY_NAMED_TASK) {
+    auto t = TraceLog::now();
+    TraceLog::record(type, -1, number, t - elapsed(), t);
+  }
+}
+
+
+namespace {
+  // ring buffer of trace events for one thread
+  struct TraceBuffer {
+    int tid;
+    std::vector<TraceEvent> events;
+    std::size_t recorded = 0;
+  };
+  std::mutex trace_mutex;
+  std::vector<std::unique_ptr<TraceBuffer>> trace_buffers;
+  std::size_t trace_capacity = 0;
+  // incremented by enable, so threads know their buffer is stale
+  int trace_generation = 0;
+
+  TraceBuffer* trace_buffer() {
+    thread_local TraceBuffer* b = nullptr;
+    thread_local int generation = -1;
+    if (generation != trace_generation) {
+      std::lock_guard<std::mutex> lock(trace_mutex);
+      trace_buffers.emplace_back(new TraceBuffer);
+      b = trace_buffers.back().get();
+      b->tid = trace_buffers.size() - 1;
+      b->events.resize(trace_capacity);
+      generation = trace_generation;
+    }
+    return b;
+  }
+}
+
+bool TraceLog::enabled_ = false;
+
+void TraceLog::enable(std::size_t events_per_thread) {
+  std::lock_guard<std::mutex> lock(trace_mutex);
+  trace_buffers.clear();
+  trace_capacity = std::max(events_per_thread, std::size_t(1));
+  trace_generation++;
+  enabled_ = true;
+}
+
+double TraceLog::now() {
+#if defined(USE_OPENMP_TIMER)
+  return GET_TIME_NOW() - TaskTimer::t_begin;
+#else
+  return duration_cast<duration<double>>
+    (GET_TIME_NOW() - TaskTimer::t_begin).count();
+#endif
+}
+
+void TraceLog::record
+(TaskType type, int front, int level, double start, double stop,
+ long long int flops) {
+  if (!enabled_) return;
+  auto b = trace_buffer();
+  b->events[b->recorded++ % b->events.size()] =
+    TraceEvent{type, front, level, b->tid, start, stop, flops};
+}
+
+void TraceLog::write(const std::string& filename) {
+  int rank = 0, P = 1;
+#if defined(STRUMPACK_USE_MPI)
+  int mpi_initialized, mpi_finalized;
+  MPI_Initialized(&mpi_initialized);
+  MPI_Finalized(&mpi_finalized);
+  if (mpi_initialized && !mpi_finalized) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &P);
+  }
+#endif
+  auto fname = filename;
+  if (P > 1) {
+    auto dot = fname.rfind('.');
+    auto r = "_" + std::to_string(rank);
+    if (dot == std::string::npos) fname += r;
+    else fname.insert(dot, r);
+  }
+  std::ofstream log(fname, std::ofstream::out);
+  if (!log) {
+    std::cerr << "# WARNING: could not open " << fname
+              << " to write the trace" << std::endl;
+    return;
+  }
+  std::lock_guard<std::mutex> lock(trace_mutex);
+  log << "{\"traceEvents\":[";
+  bool first = true;
+  for (auto& b : trace_buffers) {
+    const auto n = b->events.size();
+    const auto nev = std::min(b->recorded, n);
+    for (std::size_t i=b->recorded-nev; i<b->recorded; i++) {
+      auto& e = b->events[i % n];
+      TaskTimer t(e.type);
+      log << (first ? "\n" : ",\n") << "{\"name\":\"";
+      t.print_name(log);
+      log << "\",\"ph\":\"X\",\"pid\":" << rank
+          << ",\"tid\":" << e.tid << std::setprecision(15)
+          << ",\"ts\":" << e.start * 1e6
+          << ",\"dur\":" << (e.stop - e.start) * 1e6
+          << ",\"args\":{\"front\":" << e.front
+          << ",\"level\":" << e.level
+          << ",\"flops\":" << e.flops << "}}";
+      first = false;
+    }
+  }
+  log << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
 }
 
 
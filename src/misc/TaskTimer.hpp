@@ -64,6 +64,7 @@ namespace strumpack {
      SOLVE_LOWER_ROOT, BACKWARD_SOLVE, SOLVE_UPPER, LOOK_RIGHT,
      DISTMAT_EXTRACT_ROWS, DISTMAT_EXTRACT_COLS, DISTMAT_EXTRACT, QR,
      REDUCE_SAMPLES, COMPUTE_SAMPLES, ORTHO, REDIST_2D_TO_HSS,
+     BUILD_FRONT, FACTOR_FRONT,
      EXPLICITLY_NAMED_TASK  // leave this one last
     };
 
@@ -111,6 +112,82 @@ namespace strumpack {
     std::vector<std::list<TaskTimer>> list;
   };
 
+  /**
+   * A single task in a trace, see TraceLog.
+   */
+  struct TraceEvent {
+    TaskType type;
+    int front;     // front (separator) number, or -1
+    int level;     // level in the elimination tree, or -1
+    int tid;       // thread which recorded this event
+    double start;  // seconds since TaskTimer::t_begin
+    double stop;
+    long long int flops;
+  };
+
+  /**
+   * Records tasks, for instance the assembly and factorization of
+   * every front, in a fixed size ring buffer per thread, so the
+   * oldest events are overwritten if the buffer is full. The events
+   * can be written in the Chrome trace event format (JSON), to
+   * inspect the timeline with chrome://tracing or Perfetto. Unlike
+   * the TaskTimer lists, this is always compiled in, but recording
+   * is off unless enabled, and then costs a single branch per task.
+   */
+  class TraceLog {
+  public:
+    /**
+     * Clear all recorded events and start recording, with room for
+     * the last events_per_thread events on every thread. Should not
+     * be called while other threads are recording.
+     */
+    static void enable(std::size_t events_per_thread=(1 << 16));
+    static void disable() { enabled_ = false; }
+    static bool enabled() { return enabled_; }
+
+    /** Seconds since TaskTimer::t_begin. */
+    static double now();
+
+    static void record
+    (TaskType type, int front, int level, double start, double stop,
+     long long int flops=0);
+
+    /**
+     * Write all recorded events to filename. When running with more
+     * than one MPI process, the rank is added to the filename, as in
+     * trace_3.json. The MPI rank is used as the process id in the
+     * trace, and the thread as thread id.
+     */
+    static void write(const std::string& filename);
+
+  private:
+    static bool enabled_;
+  };
+
+  /**
+   * Records a TraceEvent for the lifetime of this object, if the
+   * TraceLog is enabled.
+   */
+  class TraceScope {
+  public:
+    TraceScope(TaskType type, int front=-1, int level=-1)
+      : type_(type), front_(front), level_(level) {
+      if (TraceLog::enabled()) start_ = TraceLog::now();
+    }
+    ~TraceScope() {
+      if (start_ >= 0)
+        TraceLog::record
+          (type_, front_, level_, start_, TraceLog::now(), flops_);
+    }
+    void add_flops(long long int f) { flops_ += f; }
+
+  private:
+    TaskType type_;
+    int front_, level_;
+    double start_ = -1.;
+    long long int flops_ = 0;
+  };
+
 #if !defined(STRUMPACK_TASK_TIMERS)
 
 #define TIMER_TIME(name, nr, timer) (void)0
@@ -124,6 +124,107 @@ namespace strumpack {
     return error;
   }
 
+  /**
+   * BiCGStab for multiple right hand sides. This runs the BiCGStab
+   * recurrence of each column of x and b simultaneously, so that
+   * spmm and the preconditioner are always applied to an n x k
+   * block. The scalars (alpha, beta, omega, rho) are per column, and
+   * a column is no longer updated once it has converged (or broke
+   * down). The iteration stops when all columns have converged.
+   */
+  template<typename scalar_t,
+           typename real_t = typename RealType<scalar_t>::value_type>
+  real_t BlockBiCGStab
+  (const std::function<void(const DenseMatrix<scalar_t>&,
+                            DenseMatrix<scalar_t>&)>& spmm,
+   const std::function<void(DenseMatrix<scalar_t>&)>& preconditioner,
+   DenseMatrix<scalar_t>& x, const DenseMatrix<scalar_t>& b,
+   real_t rtol, real_t atol, int& totit, int maxit,
+   bool non_zero_guess, bool verbose) {
+    using DenseM_t = DenseMatrix<scalar_t>;
+    const std::size_t n = x.rows(), k = x.cols();
+    DenseM_t r(n, k), r_tld(n, k), p(n, k), p_hat(n, k),
+      s_hat(n, k), v(n, k), t(n, k);
+    std::vector<real_t> bnrm2(k), error(k);
+    std::vector<scalar_t> alpha(k, scalar_t(0.)), rho(k),
+      rho_1(k, scalar_t(0.)), omega(k, scalar_t(1.));
+    std::vector<bool> active(k, true);
+    if (non_zero_guess) {      // compute initial residual
+      spmm(x, r);
+      r.scale_and_add(scalar_t(-1.), b);
+    } else {
+      r.copy(b);
+      x.zero();
+    }
+    real_t resid = real_t(0.), max_error = real_t(0.);
+    auto check_convergence = [&]() {
+      resid = max_error = real_t(0.);
+      bool conv = true;
+      for (std::size_t j=0; j<k; j++) {
+        auto rj = blas::nrm2(n, r.ptr(0, j), 1);
+        error[j] = (bnrm2[j] == real_t(0.)) ? real_t(0.) : rj / bnrm2[j];
+        resid = std::max(resid, rj);
+        max_error = std::max(max_error, error[j]);
+        if (error[j] <= rtol || rj <= atol) active[j] = false;
+        if (active[j]) conv = false;
+      }
+      if (verbose)
+        std::cout << "BlockBiCGStab it. " << totit
+                  << "\tres = " << std::setw(12) << resid
+                  << "\trel.res = " << std::setw(12) << max_error
+                  << std::endl;
+      return conv;
+    };
+    for (std::size_t j=0; j<k; j++)
+      bnrm2[j] = blas::nrm2(n, b.ptr(0, j), 1);
+    totit = 0;
+    if (check_convergence()) return max_error;
+    r_tld.copy(r);
+    for (totit=1; totit<=maxit; totit++) {
+      for (std::size_t j=0; j<k; j++) {
+        if (!active[j]) continue;
+        auto pj = p.ptr(0, j);
+        auto rj = r.ptr(0, j);
+        rho[j] = blas::dotc(n, r_tld.ptr(0, j), 1, rj, 1);
+        if (rho[j] == scalar_t(0.0)) { active[j] = false; continue; }
+        if (totit > 1) {
+          auto beta = (rho[j] / rho_1[j]) * (alpha[j] / omega[j]);
+          // p = r + beta (p - omega v)
+          blas::axpy(n, -omega[j], v.ptr(0, j), 1, pj, 1);
+          blas::axpby(n, scalar_t(1), rj, 1, beta, pj, 1);
+        } else std::copy(rj, rj+n, pj);
+      }
+      p_hat.copy(p);                          // p_hat = M \ p
+      preconditioner(p_hat);
+      spmm(p_hat, v);                         // v = A * p_hat
+      for (std::size_t j=0; j<k; j++) {
+        if (!active[j]) continue;
+        alpha[j] = rho[j] / blas::dotc(n, r_tld.ptr(0, j), 1, v.ptr(0, j), 1);
+        // s = r - alpha v, stored in r
+        blas::axpy(n, -alpha[j], v.ptr(0, j), 1, r.ptr(0, j), 1);
+        // x = x + alpha*p_hat
+        blas::axpy(n, alpha[j], p_hat.ptr(0, j), 1, x.ptr(0, j), 1);
+      }
+      s_hat.copy(r);                          // s_hat = M \ s
+      preconditioner(s_hat);
+      spmm(s_hat, t);                         // t = A*s_hat
+      for (std::size_t j=0; j<k; j++) {
+        if (!active[j]) continue;
+        auto tj = t.ptr(0, j);
+        auto tt = blas::dotc(n, tj, 1, tj, 1);
+        omega[j] = (tt == scalar_t(0.)) ? scalar_t(0.) :
+          blas::dotc(n, tj, 1, r.ptr(0, j), 1) / tt;
+        // x = x + omega*s_hat, r = s - omega*t
+        blas::axpy(n, omega[j], s_hat.ptr(0, j), 1, x.ptr(0, j), 1);
+        blas::axpy(n, -omega[j], tj, 1, r.ptr(0, j), 1);
+        if (omega[j] == scalar_t(0.0)) active[j] = false;
+        rho_1[j] = rho[j];
+      }
+      if (check_convergence()) break;
+    }
+    return max_error;
+  }
+
 } // end namespace strumpack
 
 #endif // BICGSTAB_HPP
@@ -0,0 +1,127 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*!
+ * \file CBWorkspace.hpp
+ * \brief Contains a stack allocator for the contribution blocks of
+ * the fronts in a (sequential) subtree of the elimination tree.
+ */
+#ifndef STRUMPACK_CB_WORKSPACE_HPP
+#define STRUMPACK_CB_WORKSPACE_HPP
+
+#include <cassert>
+#include <algorithm>
+#include "StrumpackParameters.hpp"
+
+namespace strumpack {
+
+  /**
+   * \class CBWorkspace
+   *
+   * \brief Preallocated stack for contribution blocks.
+   *
+   * In a postorder traversal of the elimination tree, the
+   * contribution blocks (CBs) are created and consumed in stack
+   * order: when a front is assembled, the CBs of its children are on
+   * top of the stack. The CB of the front itself is pushed on top of
+   * those of its children. Once the front has been factored, the
+   * children CBs are no longer needed, and the CB of the front is
+   * moved down, to where the CB of its first child started. The size
+   * of the stack is computed from the symbolic factorization, see
+   * FrontalMatrix::CB_workspace_size, so no memory for the CBs is
+   * allocated during the numerical factorization of the subtree.
+   *
+   * This is not thread safe, each (sequential) subtree should use
+   * its own workspace.
+   *
+   * \tparam scalar_t can be float, double, std::complex<float> or
+   * std::complex<double>.
+   */
+  template<typename scalar_t> class CBWorkspace {
+  public:
+    /**
+     * Allocate a workspace that can hold size scalars.
+     */
+    CBWorkspace(std::size_t size)
+      : data_(size ? new scalar_t[size] : nullptr), size_(size) {
+      STRUMPACK_ADD_MEMORY(size_*sizeof(scalar_t));
+    }
+    CBWorkspace(const CBWorkspace&) = delete;
+    CBWorkspace& operator=(const CBWorkspace&) = delete;
+    ~CBWorkspace() {
+      STRUMPACK_SUB_MEMORY(size_*sizeof(scalar_t));
+      delete[] data_;
+    }
+
+    /** Capacity, number of scalars. */
+    std::size_t size() const { return size_; }
+
+    /** Current top of the stack. */
+    std::size_t top() const { return top_; }
+
+    /**
+     * Allocate n scalars on top of the stack. This returns a nullptr
+     * when the stack is full, in which case the caller should
+     * allocate the memory elsewhere.
+     */
+    scalar_t* push(std::size_t n) {
+      if (top_ + n > size_) return nullptr;
+      auto p = data_ + top_;
+      top_ += n;
+      return p;
+    }
+
+    /**
+     * Release everything above mark, except for the n scalars at p,
+     * which are moved down to position mark. p should point into the
+     * stack, above mark. Returns the new location of that data.
+     */
+    scalar_t* pop_to(std::size_t mark, scalar_t* p, std::size_t n) {
+      assert(p >= data_ + mark && p + n <= data_ + top_);
+      auto d = data_ + mark;
+      if (p != d) std::copy(p, p+n, d);
+      top_ = mark + n;
+      return d;
+    }
+
+    /** Release everything above mark. */
+    void pop_to(std::size_t mark) { assert(mark <= top_); top_ = mark; }
+
+    /** Check whether p points into this workspace. */
+    bool contains(const scalar_t* p) const {
+      return p && p >= data_ && p < data_ + size_;
+    }
+
+  private:
+    scalar_t* data_ = nullptr;
+    std::size_t size_ = 0, top_ = 0;
+  };
+
+} // end namespace strumpack
+
+#endif // STRUMPACK_CB_WORKSPACE_HPP
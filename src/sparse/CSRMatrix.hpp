@@ -36,7 +36,10 @@
 #include <fstream>
 #include <vector>
 #include <tuple>
+#include <limits>
+#include <cstdint>
 #include "misc/Tools.hpp"
+#include "misc/MappedFile.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "dense/DistributedMatrix.hpp"
 #endif
@@ -236,12 +239,9 @@ namespace strumpack {
     fs.write((char*)&n_, sizeof(integer_t));
     fs.write((char*)&nnz_, sizeof(integer_t));
 
-    for (integer_t i=0; i<n_+1; i++)
-      fs.write((char*)(&ptr_[i]), sizeof(integer_t));
-    for (integer_t i=0; i<nnz_; i++)
-      fs.write((char*)(&ind_[i]), sizeof(integer_t));
-    for (integer_t i=0; i<nnz_; i++)
-      fs.write((char*)(&(val_[i])), sizeof(scalar_t));
+    fs.write((char*)ptr_.data(), (n_+1)*sizeof(integer_t));
+    fs.write((char*)ind_.data(), nnz_*sizeof(integer_t));
+    fs.write((char*)val_.data(), nnz_*sizeof(scalar_t));
 
     if (!fs.good()) {
       std::cout << "Error writing to file !!" << std::endl;
@@ -256,33 +256,58 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> int
   CSRMatrix<scalar_t,integer_t>::read_binary(const std::string& filename) {
-    std::ifstream fs(filename, std::ifstream::in | std::ifstream::binary);
-    char s;
-    fs.read(&s, sizeof(s));
-    if (s != 'R') {
+    // The file is memory mapped, and the ptr, ind and val arrays are
+    // copied with multiple threads directly into the CSR storage.
+    MappedFile f(filename);
+    if (!f.good() || f.size() < 3) {
+      std::cerr << "Error: could not read file " << filename << std::endl;
+      return 1;
+    }
+    auto p = f.data();
+    if (p[0] != 'R') {
       std::cerr << "Error: matrix is not in binary CSR format." << std::endl;
-      return 1;//throw "Error: matrix is not in binary CSR format.";
+      return 1;
     }
-    fs.read(&s, sizeof(s));
-    if (sizeof(integer_t) != s-'0') {
-      std::cerr << "Error: matrix integer_t type does not match,"
-        " input matrix uses " << (s-'0') << " bytes per integer."
-                << std::endl;
-      //throw "Error: matrix integer_t type does not match input matrix.";
+    // the integers in the file can be 4 or 8 bytes, they are
+    // converted if this does not match integer_t
+    const std::size_t is = p[1] - '0';
+    if (is != 4 && is != 8) {
+      std::cerr << "Error: invalid integer size in input matrix: "
+                << p[1] << std::endl;
       return 1;
     }
-    fs.read(&s, sizeof(s));
+    const char s = p[2];
     if ((!is_complex<scalar_t>() && std::is_same<real_t,float>() && s!='s') ||
         (!is_complex<scalar_t>() && std::is_same<real_t,double>() && s!='d') ||
         (is_complex<scalar_t>() && std::is_same<real_t,float>() && s!='c') ||
         (is_complex<scalar_t>() && std::is_same<real_t,double>() && s!='z')) {
       std::cerr << "Error: scalar type of input matrix does not match,"
         " input matrix is of type " << s << std::endl;
-      return 1;//throw "Error: scalar type of input matrix does not match";
+      return 1;
     }
-    fs.read((char*)&n_, sizeof(integer_t));
-    fs.read((char*)&n_, sizeof(integer_t));
-    fs.read((char*)&nnz_, sizeof(integer_t));
+    auto get_int = [is](const char* q) -> long long {
+      if (is == 4) { std::int32_t i; std::memcpy(&i, q, 4); return i; }
+      std::int64_t i; std::memcpy(&i, q, 8); return i;
+    };
+    const std::size_t hdr = 3 + 3 * is;
+    if (f.size() < hdr) {
+      std::cerr << "Error: binary matrix file is truncated." << std::endl;
+      return 1;
+    }
+    long long n = get_int(p + 3 + is), nnz = get_int(p + 3 + 2 * is);
+    if (n < 0 || nnz < 0 || f.size() < hdr + (n + 1 + nnz) * is +
+        nnz * sizeof(scalar_t)) {
+      std::cerr << "Error: binary matrix file is truncated." << std::endl;
+      return 1;
+    }
+    if (n > std::numeric_limits<integer_t>::max() ||
+        nnz > std::numeric_limits<integer_t>::max()) {
+      std::cerr << "Error: matrix is too large for the integer type,"
+                << " use 64 bit integers" << std::endl;
+      return 1;
+    }
+    n_ = n;
+    nnz_ = nnz;
     std::cout << "# Reading matrix with n="
               << number_format_with_commas(n_)
               << ", nnz=" << number_format_with_commas(nnz_)
@@ -291,13 +316,19 @@ namespace strumpack {
     ptr_.resize(n_+1);
     ind_.resize(nnz_);
     val_.resize(nnz_);
-    for (integer_t i=0; i<n_+1; i++)
-      fs.read((char*)(&ptr_[i]), sizeof(integer_t));
-    for (integer_t i=0; i<nnz_; i++)
-      fs.read((char*)(&ind_[i]), sizeof(integer_t));
-    for (integer_t i=0; i<nnz_; i++)
-      fs.read((char*)(&val_[i]), sizeof(scalar_t));
-    fs.close();
+    auto read_ints = [&](integer_t* dst, const char* src, integer_t cnt) {
+      if (is == sizeof(integer_t))
+        parallel_copy(dst, src, cnt * sizeof(integer_t));
+      else {
+#pragma omp parallel for
+        for (integer_t i=0; i<cnt; i++)
+          dst[i] = get_int(src + i * is);
+      }
+    };
+    read_ints(ptr_.data(), p + hdr, n_+1);
+    read_ints(ind_.data(), p + hdr + (n_+1) * is, nnz_);
+    parallel_copy(val_.data(), p + hdr + (n_+1+nnz_) * is,
+                  nnz_ * sizeof(scalar_t));
     return 0;
   }
 
@@ -346,51 +377,114 @@ namespace strumpack {
     STRUMPACK_BYTES(this->spmv_bytes());
   }
 
+  // all columns of x are handled in a single sweep over the matrix
   template<typename scalar_t,typename integer_t> void
   CSRMatrix<scalar_t,integer_t>::spmv
   (const DenseM_t& x, DenseM_t& y) const {
     // assert(x.cols() == y.cols());
     // assert(x.rows() == std::size_t(n_));
     // assert(y.rows() == std::size_t(n_));
-    for (std::size_t c=0; c<x.cols(); c++)
-      spmv(x.ptr(0,c), y.ptr(0,c));
+    const std::size_t k = x.cols(), ldx = x.ld();
+    if (k == 1) {
+      spmv(x.data(), y.data());
+      return;
+    }
+#pragma omp parallel
+    {
+      std::vector<scalar_t> yr(k);
+#pragma omp for
+      for (integer_t r=0; r<n_; r++) {
+        std::fill(yr.begin(), yr.end(), scalar_t(0.));
+        const auto hij = ptr_[r+1];
+        for (integer_t j=ptr_[r]; j<hij; j++) {
+          const auto v = val_[j];
+          const auto px = x.ptr(ind_[j], 0);
+          for (std::size_t c=0; c<k; c++)
+            yr[c] += v * px[c*ldx];
+        }
+        for (std::size_t c=0; c<k; c++)
+          y(r, c) = yr[c];
+      }
+    }
+    STRUMPACK_FLOPS(k*this->spmv_flops());
+    STRUMPACK_BYTES(this->spmv_bytes() + (k-1)*3*n_*sizeof(scalar_t));
   }
 
-  // TODO use MKL routines for better performance
+  // The rows are split in blocks with about the same number of
+  // nonzeros, one per thread. Every block scatters into a private
+  // buffer which only covers the range of column indices of that
+  // block, and the buffers are summed in a second parallel loop.
   template<typename scalar_t,typename integer_t> void
   CSRMatrix<scalar_t,integer_t>::spmv
   (Trans op, const DenseM_t& x, DenseM_t& y) const {
-    if (op != Trans::N) y.zero();
-    for (std::size_t c=0; c<x.cols(); c++) {
-      auto px = x.ptr(0, c);
-      auto py = y.ptr(0, c);
-      if (op == Trans::N) {
-        for (integer_t r=0; r<n_; r++) {
-          const auto hij = ptr_[r+1];
-          scalar_t yr(0);
-          for (integer_t j=ptr_[r]; j<hij; j++)
-            yr += val_[j] * px[ind_[j]];
-          py[r] = yr;
-        }
-      } else if (op == Trans::T) {
+    if (op == Trans::N) {
+      spmv(x, y);
+      return;
+    }
+    const std::size_t k = x.cols();
+    const int B = std::max(1, std::min(params::num_threads, int(n_)));
+    if (B == 1) {
+      // sequential, scatter directly in y, one column at a time
+      y.zero();
+      for (std::size_t c=0; c<k; c++) {
+        auto px = x.ptr(0, c);
+        auto py = y.ptr(0, c);
         for (integer_t r=0; r<n_; r++) {
           const auto hij = ptr_[r+1];
           for (integer_t j=ptr_[r]; j<hij; j++)
-            py[ind_[j]] += val_[j] * px[r];
+            py[ind_[j]] += ((op == Trans::C) ? blas::my_conj(val_[j]) :
+                            val_[j]) * px[r];
         }
-      } else if (op == Trans::C) {
-        for (integer_t r=0; r<n_; r++) {
-          const auto hij = ptr_[r+1];
-          for (integer_t j=ptr_[r]; j<hij; j++)
-            py[ind_[j]] += blas::my_conj(val_[j]) * px[r];
+      }
+      STRUMPACK_FLOPS(k*this->spmv_flops());
+      STRUMPACK_BYTES(k*this->spmv_bytes());
+      return;
+    }
+    std::vector<integer_t> blo(B+1), cmin(B, n_), cmax(B, 0);
+    for (int b=0; b<B; b++)
+      blo[b] = std::lower_bound
+        (ptr_.begin(), ptr_.begin()+n_, integer_t(nnz_ * std::int64_t(b) / B))
+        - ptr_.begin();
+    blo[B] = n_;
+    std::vector<std::vector<scalar_t>> buf(B);
+#pragma omp parallel for schedule(static,1)
+    for (int b=0; b<B; b++) {
+      auto& lo = cmin[b];
+      auto& hi = cmax[b];
+      for (integer_t j=ptr_[blo[b]]; j<ptr_[blo[b+1]]; j++) {
+        lo = std::min(lo, ind_[j]);
+        hi = std::max(hi, ind_[j]+1);
+      }
+      if (lo >= hi) continue;
+      // the buffer is stored row major, so that the k columns of a
+      // row are contiguous
+      auto& yb = buf[b];
+      yb.assign(std::size_t(hi - lo)*k, scalar_t(0.));
+      std::vector<scalar_t> xr(k);
+      for (integer_t r=blo[b]; r<blo[b+1]; r++) {
+        for (std::size_t c=0; c<k; c++) xr[c] = x(r, c);
+        const auto hij = ptr_[r+1];
+        for (integer_t j=ptr_[r]; j<hij; j++) {
+          const auto v = (op == Trans::C) ? blas::my_conj(val_[j]) : val_[j];
+          auto yi = &yb[std::size_t(ind_[j] - lo)*k];
+          for (std::size_t c=0; c<k; c++)
+            yi[c] += v * xr[c];
         }
       }
     }
-    STRUMPACK_FLOPS(x.cols()*this->spmv_flops());
-    STRUMPACK_BYTES(x.cols()*this->spmv_bytes());
+#pragma omp parallel for
+    for (integer_t i=0; i<n_; i++)
+      for (std::size_t c=0; c<k; c++) {
+        scalar_t yi(0.);
+        for (int b=0; b<B; b++)
+          if (i >= cmin[b] && i < cmax[b])
+            yi += buf[b][std::size_t(i-cmin[b])*k+c];
+        y(i, c) = yi;
+      }
+    STRUMPACK_FLOPS(k*this->spmv_flops());
+    STRUMPACK_BYTES(k*this->spmv_bytes());
   }
 
-
   template<typename scalar_t,typename integer_t> void
   CSRMatrix<scalar_t,integer_t>::strumpack_mc64
   (int_t job, int_t* num, integer_t* perm, int_t liw, int_t* iw, int_t ldw,
@@ -454,7 +548,7 @@ namespace strumpack {
   }
 
   // TODO parallel -> will be hard to do efficiently
-  // assume F11, F12 and F21 are set to zero
+  // assume F11, F12 and F21 are set to zero, F12 can be empty
   template<typename scalar_t,typename integer_t> void
   CSRMatrix<scalar_t,integer_t>::extract_front
   (DenseM_t& F11, DenseM_t& F12, DenseM_t& F21, integer_t sep_begin,
@@ -471,6 +565,7 @@ namespace strumpack {
           if (col < sep_end)
             F11(row, col-sep_begin) = val_[j];
           else {
+            if (!F12.cols()) break; // F12 not stored (Cholesky)
             while (upd_ptr<dim_upd && upd[upd_ptr]<col)
               upd_ptr++;
             if (upd_ptr == dim_upd) break;
@@ -782,33 +877,74 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> int
   CSRMatrix<scalar_t,integer_t>::read_matrix_market
   (const std::string& filename) {
-    std::vector<std::tuple<integer_t,integer_t,scalar_t>> A;
-    try {
-      A = this->read_matrix_market_entries(filename);
-    } catch (...) { return 1; }
-    std::sort
-      (A.begin(), A.end(),
-       [](const std::tuple<integer_t,integer_t,scalar_t>& a,
-          const std::tuple<integer_t,integer_t,scalar_t>& b) -> bool {
-        // sort based on the row,column indices
-        return std::make_tuple(std::get<0>(a),std::get<1>(a)) <
-          std::make_tuple(std::get<0>(b), std::get<1>(b));
+    // The file is memory mapped and parsed in chunks by multiple
+    // threads, twice: first to count the number of nonzeros in each
+    // row, then to put each entry directly in its row. Finally the
+    // column indices in each row are sorted.
+    std::cout << "# opening file \'" << filename << "\'" << std::endl;
+    MappedFile f(filename);
+    if (!f.good()) {
+      std::cerr << "ERROR: could not read file " << filename << std::endl;
+      return 1;
+    }
+    mm::Header h;
+    if (!mm::read_header<scalar_t>(f.data(), f.end(), h)) return 1;
+    std::cout << "# reading " << number_format_with_commas(h.m) << " by "
+              << number_format_with_commas(h.n) << " matrix with "
+              << number_format_with_commas(h.nnz) << " nnz's from "
+              << filename << std::endl;
+    if (h.m != h.n) {
+      std::cerr << "ERROR: matrix is not square!" << std::endl;
+      return 1;
+    }
+    if (h.n > std::numeric_limits<integer_t>::max() ||
+        h.expanded_nnz() > std::numeric_limits<integer_t>::max()) {
+      std::cerr << "ERROR: matrix is too large for the integer type,"
+                << " use 64 bit integers" << std::endl;
+      return 1;
+    }
+    const char *b = f.data() + h.data_begin, *e = f.end();
+    // count[r] is the number of entries with row index r as it
+    // appears in the file, so 0 or 1 based
+    std::vector<integer_t> count(h.n+1, 0);
+    long long imin = 1, imax = 0;
+    bool ok = mm::for_each_entry_parallel<scalar_t>
+      (b, e, h, imin, imax, [&](long long, long long r, long long,
+                                scalar_t) {
+#pragma omp atomic
+        count[r]++;
       });
-
+    // the indices are 1 based, unless there is a 0 index
+    const integer_t base = (imin == 0) ? 0 : 1;
+    if (!ok || (base == 0 && imax == h.n)) {
+      std::cerr << "ERROR: could not parse the entries in "
+                << filename << std::endl;
+      return 1;
+    }
+    n_ = h.n;
+    symm_sparse_ = h.sym != mm::Symmetry::GENERAL;
     ptr_.resize(n_+1);
+    ptr_[0] = 0;
+    for (integer_t i=0; i<n_; i++) {
+      ptr_[i+1] = ptr_[i] + count[i+base];
+      count[i+base] = ptr_[i];
+    }
+    nnz_ = ptr_[n_];
     ind_.resize(nnz_);
     val_.resize(nnz_);
-    integer_t row = -1;
-    for (integer_t i=0; i<nnz_; i++) {
-      val_[i] = std::get<2>(A[i]);
-      ind_[i] = std::get<1>(A[i]);
-      auto new_row = std::get<0>(A[i]);
-      if (new_row != row) {
-        for (int j=row+1; j<=new_row; j++) ptr_[j] = i;
-        row = new_row;
-      }
-    }
-    for (int j=row+1; j<=n_; j++) ptr_[j] = nnz_;
+    mm::for_each_entry_parallel<scalar_t>
+      (b, e, h, imin, imax, [&](long long, long long r, long long c,
+                                scalar_t v) {
+        integer_t j;
+#pragma omp atomic capture
+        j = count[r]++;
+        ind_[j] = c - base;
+        val_[j] = v;
+      });
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (integer_t r=0; r<n_; r++)
+      sort_indices_values<scalar_t>
+        (ind_.data(), val_.data(), ptr_[r], ptr_[r+1]);
     return 0;
   }
 
@@ -37,8 +37,12 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <limits>
+#include <numeric>
 
 #include "misc/MPIWrapper.hpp"
+#include "misc/MappedFile.hpp"
+#include "MatrixMarket.hpp"
 #include "dense/BLASLAPACKWrapper.hpp"
 #include "CSRGraph.hpp"
 #if defined(STRUMPACK_USE_COMBBLAS)
@@ -50,6 +54,29 @@ namespace strumpack {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
   template<typename scalar_t,typename integer_t> class SPMVBuffers {
   public:
+    SPMVBuffers() = default;
+    // the persistent requests refer to the buffers of this object, so
+    // a copy starts uninitialized
+    SPMVBuffers(const SPMVBuffers&) {}
+    SPMVBuffers& operator=(const SPMVBuffers&) {
+      free_requests();
+      initialized = false;
+      sranks.clear();  rranks.clear();
+      soff.clear();    roffs.clear();
+      sind.clear();    sbuf.clear();   rbuf.clear();
+      prbuf.clear();   poff.clear();
+      return *this;
+    }
+    ~SPMVBuffers() { free_requests(); }
+
+    void free_requests() {
+      int finalized;
+      MPI_Finalized(&finalized);
+      if (!finalized)
+        for (auto& r : req) MPI_Request_free(&r);
+      req.clear();
+    }
+
     bool initialized = false;
     std::vector<integer_t> sranks;
     // ranks of the process from which I need to receive something
@@ -64,6 +91,11 @@ namespace strumpack {
     // for each off-diagonal entry spmv_prbuf stores the
     // corresponding index in the receive buffer
     std::vector<integer_t> prbuf;
+    // start of the off-diagonal entries of each row in prbuf
+    std::vector<integer_t> poff;
+    // persistent requests, first the receives (one per rank in
+    // rranks), then the sends (one per rank in sranks)
+    std::vector<MPI_Request> req;
   };
 #endif //DOXYGEN_SHOULD_SKIP_THIS
 
@@ -116,6 +148,13 @@ namespace strumpack {
      const std::vector<scalar_t>& Dc) override;
     void permute(const integer_t* iorder, const integer_t* order) override;
     std::unique_ptr<CSRMatrix<scalar_t,integer_t>> gather() const;
+    /**
+     * Gather the sparsity pattern, without the diagonal and without
+     * the values, to the root process (rank 0 in comm()). This is
+     * collective on comm(). Returns a null pointer on all other
+     * ranks.
+     */
+    std::unique_ptr<CSRGraph<integer_t>> gather_graph() const;
     int permute_and_scale
     (MatchingJob job, std::vector<integer_t>& perm,
      std::vector<scalar_t>& Dr,
@@ -129,6 +168,21 @@ namespace strumpack {
     void symmetrize_sparsity() override;
     int read_matrix_market(const std::string& filename) override;
 
+    /**
+     * Read a matrix in the Matrix Market format, collective on
+     * comm. Each process parses its own part of the file (with
+     * multiple threads), and the entries are sent to the process
+     * owning their row with a single all-to-all. The rows are
+     * distributed over the processes to balance the number of
+     * nonzeros. Not a single process reads, or stores, the entire
+     * matrix. Returns 0 on success, the same on all processes.
+     *
+     * \param filename name of the Matrix Market file
+     * \param comm MPI communicator, this matrix will use (not
+     * duplicate) this communicator
+     */
+    int read_matrix_market(const std::string& filename, MPI_Comm comm);
+
     real_t max_scaled_residual
     (const DenseM_t& x, const DenseM_t& b) const override;
     real_t max_scaled_residual
@@ -206,6 +260,9 @@ namespace strumpack {
   protected:
     void split_diag_offdiag();
     void setup_spmv_buffers() const;
+    void start_halo_exchange(const scalar_t* x) const;
+    void wait_halo_recv() const;
+    void wait_halo_send() const;
 
     // TODO use MPIComm
     MPI_Comm _comm;
@@ -657,12 +714,16 @@ namespace strumpack {
       (std::unique(spmv_rind.begin(), spmv_rind.end()), spmv_rind.end());
 
     spmv_bufs_.prbuf.reserve(nr_offdiag_nnz);
-    for (integer_t r=0; r<local_rows_; r++)
+    spmv_bufs_.poff.resize(local_rows_+1);
+    for (integer_t r=0; r<local_rows_; r++) {
+      spmv_bufs_.poff[r] = spmv_bufs_.prbuf.size();
       for (integer_t j=offdiag_start_[r]; j<ptr_[r+1]; j++)
         spmv_bufs_.prbuf.push_back
           (std::distance
            (spmv_rind.begin(), std::lower_bound
             (spmv_rind.begin(), spmv_rind.end(), ind_[j])));
+    }
+    spmv_bufs_.poff[local_rows_] = spmv_bufs_.prbuf.size();
 
     // how much to receive from each proc
     for (size_t p=0, j=0; p<size_t(P); p++)
@@ -715,6 +776,51 @@ namespace strumpack {
 
     spmv_bufs_.rbuf.resize(spmv_rind.size());
     spmv_bufs_.sbuf.resize(spmv_bufs_.sind.size());
+
+    // the same messages are exchanged in every spmv, so set up
+    // persistent requests once
+    spmv_bufs_.req.resize(nr_recv_procs + nr_send_procs);
+    for (int p=0; p<nr_recv_procs; p++)
+      MPI_Recv_init
+        (spmv_bufs_.rbuf.data() + spmv_bufs_.roffs[p],
+         spmv_bufs_.roffs[p+1] - spmv_bufs_.roffs[p],
+         mpi_type<scalar_t>(), spmv_bufs_.rranks[p],
+         0, _comm, &spmv_bufs_.req[p]);
+    for (int p=0; p<nr_send_procs; p++)
+      MPI_Send_init
+        (spmv_bufs_.sbuf.data() + spmv_bufs_.soff[p],
+         spmv_bufs_.soff[p+1] - spmv_bufs_.soff[p],
+         mpi_type<scalar_t>(), spmv_bufs_.sranks[p],
+         0, _comm, &spmv_bufs_.req[nr_recv_procs+p]);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  CSRMatrixMPI<scalar_t,integer_t>::start_halo_exchange
+  (const scalar_t* x) const {
+    setup_spmv_buffers();
+    auto& B = spmv_bufs_;
+    auto nr = B.rranks.size();
+    // post the receives before packing the send buffer
+    MPI_Startall(nr, B.req.data());
+#pragma omp parallel for
+    for (std::size_t i=0; i<B.sind.size(); i++)
+      B.sbuf[i] = x[B.sind[i]-begin_row_];
+    MPI_Startall(B.sranks.size(), B.req.data()+nr);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  CSRMatrixMPI<scalar_t,integer_t>::wait_halo_recv() const {
+    MPI_Waitall
+      (spmv_bufs_.rranks.size(), spmv_bufs_.req.data(),
+       MPI_STATUSES_IGNORE);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  CSRMatrixMPI<scalar_t,integer_t>::wait_halo_send() const {
+    MPI_Waitall
+      (spmv_bufs_.sranks.size(),
+       spmv_bufs_.req.data() + spmv_bufs_.rranks.size(),
+       MPI_STATUSES_IGNORE);
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -730,29 +836,7 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   CSRMatrixMPI<scalar_t,integer_t>::spmv
   (const scalar_t* x, scalar_t* y) const {
-    setup_spmv_buffers();
-
-    for (size_t i=0; i<spmv_bufs_.sind.size(); i++)
-      spmv_bufs_.sbuf[i] =
-        x[spmv_bufs_.sind[i]-begin_row_];
-
-    MPI_Request* sreq = new MPI_Request
-      [spmv_bufs_.sranks.size() +
-       spmv_bufs_.rranks.size()];
-    MPI_Request* rreq = sreq + spmv_bufs_.sranks.size();
-    for (size_t p=0; p<spmv_bufs_.sranks.size(); p++)
-      MPI_Isend
-        (spmv_bufs_.sbuf.data() + spmv_bufs_.soff[p],
-         spmv_bufs_.soff[p+1] - spmv_bufs_.soff[p],
-         mpi_type<scalar_t>(), spmv_bufs_.sranks[p],
-         0, _comm, &sreq[p]);
-
-    for (size_t p=0; p<spmv_bufs_.rranks.size(); p++)
-      MPI_Irecv
-        (spmv_bufs_.rbuf.data() + spmv_bufs_.roffs[p],
-         spmv_bufs_.roffs[p+1] - spmv_bufs_.roffs[p],
-         mpi_type<scalar_t>(), spmv_bufs_.rranks[p],
-         0, _comm, &rreq[p]);
+    start_halo_exchange(x);
 
     // first do the block diagonal part, while the communication is going on
 #pragma omp parallel for
@@ -763,20 +847,20 @@ namespace strumpack {
       y[r] = yrow;
     }
     // wait for incoming messages
-    MPI_Waitall
-      (spmv_bufs_.rranks.size(), rreq, MPI_STATUSES_IGNORE);
+    wait_halo_recv();
 
     // do the block off-diagonal part of the matrix
-    // TODO some openmp here
-    auto pbuf = spmv_bufs_.prbuf.begin();
-    for (integer_t r=0; r<local_rows(); r++)
+#pragma omp parallel for
+    for (integer_t r=0; r<local_rows(); r++) {
+      auto pbuf = spmv_bufs_.prbuf.data() + spmv_bufs_.poff[r];
+      auto yrow = y[r];
       for (integer_t j=offdiag_start_[r]; j<ptr_[r+1]; j++)
-        y[r] += val_[j] * spmv_bufs_.rbuf[*pbuf++];
+        yrow += val_[j] * spmv_bufs_.rbuf[*pbuf++];
+      y[r] = yrow;
+    }
 
     // wait for all send messages to finish
-    MPI_Waitall
-      (spmv_bufs_.sranks.size(), sreq, MPI_STATUSES_IGNORE);
-    delete[] sreq;
+    wait_halo_send();
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -843,6 +927,62 @@ namespace strumpack {
     }
   }
 
+  template<typename scalar_t,typename integer_t>
+  std::unique_ptr<CSRGraph<integer_t>>
+  CSRMatrixMPI<scalar_t,integer_t>::gather_graph() const {
+    auto rank = mpi_rank(_comm);
+    auto P = mpi_nprocs(_comm);
+    // local sparsity pattern, without the diagonal
+    std::vector<integer_t> lptr(local_rows_+1), lind;
+    lind.reserve(local_nnz_);
+    lptr[0] = 0;
+    for (integer_t r=0; r<local_rows_; r++) {
+      for (integer_t j=ptr_[r]; j<ptr_[r+1]; j++)
+        if (ind_[j] != r + begin_row_) lind.push_back(ind_[j]);
+      lptr[r+1] = lind.size();
+    }
+    integer_t lnnz = lind.size();
+    if (rank == 0) {
+      std::unique_ptr<int[]> iwork(new int[2*P]);
+      auto rcnts = iwork.get();
+      auto displs = rcnts + P;
+      for (int p=0; p<P; p++) {
+        rcnts[p] = dist_[p+1]-dist_[p];
+        displs[p] = dist_[p];
+      }
+      std::vector<integer_t> gptr(n_+1);
+      MPI_Gatherv
+        (lptr.data()+1, local_rows_, mpi_type<integer_t>(),
+         gptr.data()+1, rcnts, displs, mpi_type<integer_t>(), 0, _comm);
+      gptr[0] = 0;
+      for (int p=1; p<P; p++) {
+        if (dist_[p] > 0) {
+          integer_t p_start = gptr[dist_[p]];
+          for (int r=dist_[p]; r<dist_[p+1]; r++)
+            gptr[r+1] += p_start;
+        }
+      }
+      for (int p=0; p<P; p++) {
+        rcnts[p] = gptr[dist_[p+1]] - gptr[dist_[p]];
+        displs[p] = gptr[dist_[p]];
+      }
+      std::vector<integer_t> gind(gptr[n_]);
+      MPI_Gatherv
+        (lind.data(), lnnz, mpi_type<integer_t>(), gind.data(),
+         rcnts, displs, mpi_type<integer_t>(), 0, _comm);
+      return std::unique_ptr<CSRGraph<integer_t>>
+        (new CSRGraph<integer_t>(std::move(gptr), std::move(gind)));
+    } else {
+      MPI_Gatherv
+        (lptr.data()+1, local_rows_, mpi_type<integer_t>(),
+         NULL, NULL, NULL, mpi_type<integer_t>(), 0, _comm);
+      MPI_Gatherv
+        (lind.data(), lnnz, mpi_type<integer_t>(),
+         NULL, NULL, NULL, mpi_type<integer_t>(), 0, _comm);
+      return std::unique_ptr<CSRGraph<integer_t>>();
+    }
+  }
+
   template<typename scalar_t,typename integer_t> int
   CSRMatrixMPI<scalar_t,integer_t>::permute_and_scale
   (MatchingJob job, std::vector<integer_t>& perm, std::vector<scalar_t>& Dr,
@@ -1094,15 +1234,190 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> int
   CSRMatrixMPI<scalar_t,integer_t>::read_matrix_market
   (const std::string& filename) {
-    std::cout << "ERROR: reading a distributed matrix"
-              << " from file is not supported." << std::endl;
-    abort();
-    // TODO: first read the matrix as a sequential matrix
-    // then make a Distributed matrix from the sequential one
-    // Aydin has code for MPI-IO input of matrix-market file
-    return 0;
+    return read_matrix_market
+      (filename, _comm == MPI_COMM_NULL ? MPI_COMM_WORLD : _comm);
   }
 
+  template<typename scalar_t,typename integer_t> int
+  CSRMatrixMPI<scalar_t,integer_t>::read_matrix_market
+  (const std::string& filename, MPI_Comm comm) {
+    _comm = comm;
+    auto P = mpi_nprocs(_comm);
+    auto rank = mpi_rank(_comm);
+    // every rank maps the file, but only touches the pages in its
+    // own byte range
+    MappedFile f(filename);
+    int ok = f.good();
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, mpi_type<int>(), MPI_MIN, _comm);
+    if (!ok) {
+      if (!rank)
+        std::cerr << "ERROR: could not read file " << filename << std::endl;
+      return 1;
+    }
+    mm::Header h;
+    if (!rank) {
+      std::cout << "# opening file \'" << filename << "\'" << std::endl;
+      ok = mm::read_header<scalar_t>(f.data(), f.end(), h);
+      if (ok) {
+        std::cout << "# reading " << number_format_with_commas(h.m)
+                  << " by " << number_format_with_commas(h.n)
+                  << " matrix with " << number_format_with_commas(h.nnz)
+                  << " nnz's from " << filename << " on "
+                  << P << " processes" << std::endl;
+        if (h.m != h.n) {
+          std::cerr << "ERROR: matrix is not square!" << std::endl;
+          ok = 0;
+        } else if (h.n > std::numeric_limits<integer_t>::max() ||
+                   h.expanded_nnz() > std::numeric_limits<integer_t>::max()) {
+          std::cerr << "ERROR: matrix is too large for the integer type,"
+                    << " use 64 bit integers" << std::endl;
+          ok = 0;
+        }
+      }
+    }
+    MPI_Bcast(&ok, 1, mpi_type<int>(), 0, _comm);
+    if (!ok) return 1;
+    MPI_Bcast(&h, sizeof(h), MPI_BYTE, 0, _comm);
+
+    // parse the entries in this rank's part of the file
+    struct RCVal { integer_t r, c; scalar_t v; };
+    const char *b = f.data() + h.data_begin, *e = f.end();
+    const auto len = e - b;
+    auto lo = mm::line_begin(b, b + rank * len / P, e),
+      hi = mm::line_begin(b, b + (rank+1) * len / P, e);
+    std::vector<std::vector<RCVal>> Ec(mm::chunks(hi - lo));
+    long long imin = 1, imax = 0;
+    ok = mm::for_each_entry_parallel<scalar_t>
+      (lo, hi, h, imin, imax, [&](long long k, long long r, long long c,
+                                  scalar_t v) {
+        Ec[k].push_back(RCVal{integer_t(r), integer_t(c), v});
+      });
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, mpi_type<int>(), MPI_MIN, _comm);
+    MPI_Allreduce
+      (MPI_IN_PLACE, &imin, 1, mpi_type<long long>(), MPI_MIN, _comm);
+    MPI_Allreduce
+      (MPI_IN_PLACE, &imax, 1, mpi_type<long long>(), MPI_MAX, _comm);
+    // the indices are 1 based, unless there is a 0 index
+    const integer_t base = (imin == 0) ? 0 : 1;
+    if (!ok || (base == 0 && imax == h.n)) {
+      if (!rank)
+        std::cerr << "ERROR: could not parse the entries in "
+                  << filename << std::endl;
+      return 1;
+    }
+    n_ = h.n;
+    symm_sparse_ = h.sym != mm::Symmetry::GENERAL;
+
+    // Choose the row distribution from a global histogram of the
+    // number of nonzeros in nb buckets of rows. This balances the
+    // nonzeros to within about 1/16th of the average per process,
+    // without a reduction over all n rows.
+    const long long nb =
+      std::max<long long>(1, std::min<long long>(n_, 16*P));
+    auto bucket_begin = [&](long long k) { return (k * n_ + nb - 1) / nb; };
+    std::vector<long long> bcnt(nb, 0);
+    for (auto& E : Ec)
+      for (auto& t : E) {
+        t.r -= base;
+        t.c -= base;
+        bcnt[(long long)(t.r) * nb / n_]++;
+      }
+    MPI_Allreduce
+      (MPI_IN_PLACE, bcnt.data(), nb, mpi_type<long long>(), MPI_SUM, _comm);
+    dist_.resize(P+1);
+    dist_[0] = 0;
+    long long tot = std::accumulate(bcnt.begin(), bcnt.end(), 0ll);
+    for (long long k=0, p=1, sum=0; p<P; p++) {
+      long long t = p * tot / P;
+      while (k < nb && sum + bcnt[k] <= t) sum += bcnt[k++];
+      // boundary before or after bucket k, whichever is closest
+      dist_[p] = (k < nb && t - sum > sum + bcnt[k] - t) ?
+        bucket_begin(k+1) : bucket_begin(k);
+      dist_[p] = std::max(dist_[p], dist_[p-1]);
+    }
+    dist_[P] = n_;
+    begin_row_ = dist_[rank];
+    end_row_ = dist_[rank+1];
+    local_rows_ = end_row_ - begin_row_;
+
+    // route all entries to the owner of their row, with a single
+    // all-to-all
+    auto owner = [&](integer_t r) {
+      return std::upper_bound(dist_.begin(), dist_.end(), r)
+        - dist_.begin() - 1;
+    };
+    std::unique_ptr<int[]> iwork(new int[4*P]);
+    auto scnts = iwork.get();
+    auto rcnts = scnts + P;
+    auto sdispls = scnts + 2*P;
+    auto rdispls = scnts + 3*P;
+    std::fill(scnts, scnts+P, 0);
+    std::size_t ssize = 0;
+    for (auto& E : Ec) {
+      for (auto& t : E) scnts[owner(t.r)]++;
+      ssize += E.size();
+    }
+    if (ssize > std::numeric_limits<int>::max()) {
+      std::cerr << "# ERROR: 32bit integer overflow in read_matrix_market,"
+                << " use more processes" << std::endl;
+      MPI_Abort(_comm, 1);
+    }
+    MPI_Alltoall(scnts, 1, mpi_type<int>(), rcnts, 1, mpi_type<int>(), _comm);
+    sdispls[0] = rdispls[0] = 0;
+    for (int p=1; p<P; p++) {
+      sdispls[p] = sdispls[p-1] + scnts[p-1];
+      rdispls[p] = rdispls[p-1] + rcnts[p-1];
+    }
+    std::size_t rsize = std::size_t(rdispls[P-1]) + rcnts[P-1];
+    if (rsize > std::numeric_limits<int>::max()) {
+      std::cerr << "# ERROR: 32bit integer overflow in read_matrix_market,"
+                << " use more processes" << std::endl;
+      MPI_Abort(_comm, 1);
+    }
+    std::vector<RCVal> sbuf(ssize), rbuf(rsize);
+    {
+      std::vector<int> pos(sdispls, sdispls+P);
+      for (auto& E : Ec) {
+        for (auto& t : E) sbuf[pos[owner(t.r)]++] = t;
+        std::vector<RCVal>().swap(E);
+      }
+    }
+    MPI_Datatype RCVal_mpi_type;
+    MPI_Type_contiguous(sizeof(RCVal), MPI_BYTE, &RCVal_mpi_type);
+    MPI_Type_commit(&RCVal_mpi_type);
+    MPI_Alltoallv
+      (sbuf.data(), scnts, sdispls, RCVal_mpi_type, rbuf.data(),
+       rcnts, rdispls, RCVal_mpi_type, _comm);
+    MPI_Type_free(&RCVal_mpi_type);
+    std::vector<RCVal>().swap(sbuf);
+
+    // build the local rows
+    local_nnz_ = rsize;
+    ptr_.assign(local_rows_+1, 0);
+    for (auto& t : rbuf) ptr_[t.r-begin_row_+1]++;
+    for (integer_t r=0; r<local_rows_; r++) ptr_[r+1] += ptr_[r];
+    ind_.resize(local_nnz_);
+    val_.resize(local_nnz_);
+    {
+      std::vector<integer_t> pos(ptr_.begin(), ptr_.end()-1);
+      for (auto& t : rbuf) {
+        auto j = pos[t.r-begin_row_]++;
+        ind_[j] = t.c;
+        val_[j] = t.v;
+      }
+    }
+    std::vector<RCVal>().swap(rbuf);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (integer_t r=0; r<local_rows_; r++)
+      sort_indices_values<scalar_t>
+        (ind_.data(), val_.data(), ptr_[r], ptr_[r+1]);
+    MPI_Allreduce
+      (&local_nnz_, &nnz_, 1, mpi_type<integer_t>(), MPI_SUM, _comm);
+    spmv_bufs_ = SPMVBuffers<scalar_t,integer_t>();
+    split_diag_offdiag();
+    check();
+    return 0;
+  }
 
   template<typename scalar_t,typename integer_t>
   typename RealType<scalar_t>::value_type
@@ -1118,28 +1433,8 @@ namespace strumpack {
   typename RealType<scalar_t>::value_type
   CSRMatrixMPI<scalar_t,integer_t>::max_scaled_residual
   (const scalar_t* x, const scalar_t* b) const {
-    setup_spmv_buffers();
-
-    for (size_t i=0; i<spmv_bufs_.sind.size(); i++)
-      spmv_bufs_.sbuf[i] = x[spmv_bufs_.sind[i]-begin_row_];
-
-    std::vector<MPI_Request> sreq(spmv_bufs_.sranks.size());
-    for (size_t p=0; p<spmv_bufs_.sranks.size(); p++)
-      MPI_Isend
-        (spmv_bufs_.sbuf.data() + spmv_bufs_.soff[p],
-         spmv_bufs_.soff[p+1] - spmv_bufs_.soff[p],
-         mpi_type<scalar_t>(), spmv_bufs_.sranks[p],
-         0, _comm, &sreq[p]);
-
-    std::vector<MPI_Request> rreq(spmv_bufs_.rranks.size());
-    for (size_t p=0; p<spmv_bufs_.rranks.size(); p++)
-      MPI_Irecv
-        (spmv_bufs_.rbuf.data() + spmv_bufs_.roffs[p],
-         spmv_bufs_.roffs[p+1] - spmv_bufs_.roffs[p],
-         mpi_type<scalar_t>(), spmv_bufs_.rranks[p],
-         0, _comm, &rreq[p]);
-
-    MPI_Waitall(rreq.size(), rreq.data(), MPI_STATUSES_IGNORE);
+    start_halo_exchange(x);
+    wait_halo_recv();
 
     real_t m = real_t(0.);
     auto pbuf = spmv_bufs_.prbuf.begin();
@@ -1160,7 +1455,7 @@ namespace strumpack {
       m = std::max(m, std::abs(true_res) / std::abs(abs_res));
     }
     // wait for all send messages to finish
-    MPI_Waitall(sreq.size(), sreq.data(), MPI_STATUSES_IGNORE);
+    wait_halo_send();
     MPI_Allreduce(MPI_IN_PLACE, &m, 1, mpi_type<real_t>(), MPI_MAX, _comm);
     return m;
   }
@@ -37,10 +37,13 @@
 #include <vector>
 #include <algorithm>
 #include <tuple>
+#include <limits>
 #include <stdio.h>
 #include <string.h>
 #include "StrumpackOptions.hpp"
 #include "misc/Tools.hpp"
+#include "misc/MappedFile.hpp"
+#include "MatrixMarket.hpp"
 #include "dense/DenseMatrix.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "dense/DistributedMatrix.hpp"
@@ -353,8 +356,6 @@ namespace strumpack {
     std::vector<scalar_t> val_;
     bool symm_sparse_;
 
-    enum MMsym {GENERAL, SYMMETRIC, SKEWSYMMETRIC, HERMITIAN};
-
     CompressedSparseMatrix();
     CompressedSparseMatrix
     (integer_t n, integer_t nnz, bool symm_sparse=false);
@@ -560,129 +561,61 @@ namespace strumpack {
     symm_sparse_ = true;
   }
 
-  template<typename scalar_t> scalar_t get_scalar(double vr, double vi) {
-    return scalar_t(vr);
-  }
-  template<> inline std::complex<double> get_scalar(double vr, double vi) {
-    return std::complex<double>(vr, vi);
-  }
-  template<> inline std::complex<float> get_scalar(double vr, double vi) {
-    return std::complex<float>(vr, vi);
-  }
-
   template<typename scalar_t,typename integer_t>
   std::vector<std::tuple<integer_t,integer_t,scalar_t>>
   CompressedSparseMatrix<scalar_t,integer_t>::read_matrix_market_entries
   (const std::string& filename) {
     std::cout << "# opening file \'" << filename << "\'" << std::endl;
-    FILE *fp = fopen(filename.c_str(), "r");
-    if (fp == NULL) {
-      std::cerr << "ERROR: could not read file";
-      exit(1);
+    MappedFile f(filename);
+    if (!f.good()) {
+      std::cerr << "ERROR: could not read file " << filename << std::endl;
+      throw "ERROR: could not read file";
     }
-    const int max_cline = 256;
-    char cline[max_cline];
-    if (fgets(cline, max_cline, fp) == NULL) {
-      std::cerr << "ERROR: could not read from file" << std::endl;
-      exit(1);
+    mm::Header h;
+    if (!mm::read_header<scalar_t>(f.data(), f.end(), h))
+      throw "ERROR: could not read Matrix Market header";
+    std::cout << "# reading " << number_format_with_commas(h.m) << " by "
+              << number_format_with_commas(h.n) << " matrix with "
+              << number_format_with_commas(h.nnz) << " nnz's from "
+              << filename << std::endl;
+    if (h.m != h.n) {
+      std::cerr << "ERROR: matrix is not square!" << std::endl;
+      throw "ERROR: matrix is not square";
     }
-    printf("# %s", cline);
-    if (strstr(cline, "pattern")) {
-      std::cerr << "ERROR: This is not a matrix,"
-                << " but just a sparsity pattern" << std::endl;
-      exit(1);
+    if (h.n > std::numeric_limits<integer_t>::max() ||
+        h.expanded_nnz() > std::numeric_limits<integer_t>::max()) {
+      std::cerr << "ERROR: matrix is too large for the integer type,"
+                << " use 64 bit integers" << std::endl;
+      throw "ERROR: integer overflow";
     }
-    else if (strstr(cline, "complex")) {
-      if (!is_complex<scalar_t>()) {
-        fclose(fp);
-        throw "ERROR: Complex matrix";
-      }
-    }
-    MMsym s = GENERAL;
-    if (strstr(cline, "skew-symmetric")) {
-      s = SKEWSYMMETRIC;
-      symm_sparse_ = true;
-    } else if (strstr(cline, "symmetric")) {
-      s = SYMMETRIC;
-      symm_sparse_ = true;
-    } else if (strstr(cline, "hermitian")) {
-      s = HERMITIAN;
-      symm_sparse_ = true;
-    }
-
-    while (fgets(cline, max_cline, fp)) {
-      if (cline[0] != '%') { // first line should be: m n nnz
-        int m, in, innz;
-        sscanf(cline, "%d %d %d", &m, &in, &innz);
-        nnz_ = static_cast<integer_t>(innz);
-        n_ = static_cast<integer_t>(in);
-        std::cout << "# reading " << number_format_with_commas(m) << " by "
-                  << number_format_with_commas(n_) << " matrix with "
-                  << number_format_with_commas(nnz_) << " nnz's from "
-                  << filename << std::endl;
-        if (s != GENERAL) nnz_ = 2 * nnz_;
-        if (m != n_) {
-          std::cerr << "ERROR: matrix is not square!" << std::endl;
-          exit(1);
-        }
-        break;
-      }
+    n_ = h.n;
+    symm_sparse_ = h.sym != mm::Symmetry::GENERAL;
+    // parse chunks of the file in parallel, then concatenate
+    const char *b = f.data() + h.data_begin, *e = f.end();
+    std::vector<std::vector<std::tuple<integer_t,integer_t,scalar_t>>>
+      Ac(mm::chunks(e - b));
+    long long imin = 1, imax = 0;
+    bool ok = mm::for_each_entry_parallel<scalar_t>
+      (b, e, h, imin, imax, [&](long long k, long long r, long long c,
+                                scalar_t v) {
+        Ac[k].emplace_back(r, c, v);
+      });
+    // the indices are 1 based, unless there is a 0 index
+    if (!ok || (imin == 0 && imax == h.n)) {
+      std::cerr << "ERROR: could not parse the entries in "
+                << filename << std::endl;
+      throw "ERROR: could not parse file";
     }
+    std::size_t nnz = 0;
+    for (auto& A : Ac) nnz += A.size();
     std::vector<std::tuple<integer_t,integer_t,scalar_t>> A;
-    A.reserve(nnz_);
-    bool zero_based = false;
-    if (!is_complex<scalar_t>()) {
-      int ir, ic;
-      double dv;
-      while (fscanf(fp, "%d %d %lf\n", &ir, &ic, &dv) != EOF) {
-        scalar_t v = static_cast<scalar_t>(dv);
-        integer_t r = static_cast<integer_t>(ir);
-        integer_t c = static_cast<integer_t>(ic);
-        if (r==0 || c==0) zero_based = true;
-        A.push_back(std::make_tuple(r, c, v));
-        if (r != c) {
-          switch (s) {
-          case SKEWSYMMETRIC:
-            A.push_back(std::make_tuple(c, r, -v));
-            break;
-          case SYMMETRIC:
-            A.push_back(std::make_tuple(c, r, v));
-            break;
-          case HERMITIAN:
-            A.push_back(std::make_tuple(c, r, blas::my_conj(v)));
-            break;
-          default: break;
-          }
-        }
-      }
-    } else {
-      double vr=0, vi=0;
-      int ir, ic;
-      while (fscanf(fp, "%d %d %lf %lf\n", &ir, &ic, &vr, &vi) != EOF) {
-        scalar_t v = get_scalar<scalar_t>(vr, vi);
-        integer_t r = static_cast<integer_t>(ir);
-        integer_t c = static_cast<integer_t>(ic);
-        if (r==0 || c==0) zero_based = true;
-        A.push_back(std::make_tuple(r, c, v));
-        if (r != c) {
-          switch (s) {
-          case SKEWSYMMETRIC:
-            A.push_back(std::make_tuple(c, r, -v));
-            break;
-          case SYMMETRIC:
-            A.push_back(std::make_tuple(c, r, v));
-            break;
-          case HERMITIAN:
-            A.push_back(std::make_tuple(c, r, blas::my_conj(v)));
-            break;
-          default: break;
-          }
-        }
-      }
+    A.reserve(nnz);
+    for (auto& Aci : Ac) {
+      A.insert(A.end(), Aci.begin(), Aci.end());
+      std::vector<std::tuple<integer_t,integer_t,scalar_t>>().swap(Aci);
     }
     nnz_ = A.size();
-    fclose(fp);
-    if (!zero_based)
+    if (imin > 0)
       for (auto& t : A) {
         std::get<0>(t)--;
         std::get<1>(t)--;
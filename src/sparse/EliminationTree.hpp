@@ -59,12 +59,34 @@ namespace strumpack {
     virtual integer_t maximum_rank() const;
     virtual long long factor_nonzeros() const;
     virtual long long dense_factor_nonzeros() const;
+
+    /**
+     * Predicted peak memory, in number of scalars, for the
+     * factorization with options opts, see
+     * FrontalMatrix::dense_peak_memory.
+     */
+    virtual long long dense_peak_memory
+    (const SPOptions<scalar_t>& opts) const;
+
     void print_rank_statistics(std::ostream &out) const {
       root_->print_rank_statistics(out);
     }
     virtual FrontCounter front_counter() const { return nr_fronts_; }
     void draw(const SpMat_t& A, const std::string& name) const;
 
+    /**
+     * Write the tree structure and the factors of all fronts to a
+     * binary stream. Only supported for dense fronts, returns false
+     * otherwise.
+     */
+    bool write_factors(std::ostream& os) const;
+
+    /**
+     * Replace this tree with a tree (and factors) read from a
+     * stream written by write_factors. Returns false on error.
+     */
+    bool read_factors(std::istream& is);
+
     F_t* root() { return root_.get(); }
 
   protected:
@@ -82,6 +104,8 @@ namespace strumpack {
     (const SpMat_t& A, const SeparatorTree<integer_t>& sep_tree,
      integer_t sep, std::vector<std::vector<integer_t>>& upd,
      int depth=0) const;
+
+    std::unique_ptr<F_t> read_front(std::istream& is);
   };
 
 
@@ -226,6 +250,53 @@ namespace strumpack {
     return nonzeros;
   }
 
+  template<typename scalar_t,typename integer_t> long long
+  EliminationTree<scalar_t,integer_t>::dense_peak_memory
+  (const SPOptions<scalar_t>& opts) const {
+    long long after = 0;
+    return root_->dense_peak_memory(opts, after);
+  }
+
+  template<typename scalar_t,typename integer_t> bool
+  EliminationTree<scalar_t,integer_t>::write_factors
+  (std::ostream& os) const {
+    return root_->write(os);
+  }
+
+  template<typename scalar_t,typename integer_t> bool
+  EliminationTree<scalar_t,integer_t>::read_factors(std::istream& is) {
+    nr_fronts_ = FrontCounter();
+    root_ = read_front(is);
+    return root_ != nullptr;
+  }
+
+  template<typename scalar_t,typename integer_t>
+  std::unique_ptr<FrontalMatrix<scalar_t,integer_t>>
+  EliminationTree<scalar_t,integer_t>::read_front(std::istream& is) {
+    std::int64_t hdr[6];
+    is.read((char*)hdr, sizeof(hdr));
+    if (!is.good() || hdr[3] < 0) return nullptr;
+    std::vector<integer_t> upd(hdr[3]);
+    is.read((char*)upd.data(), sizeof(integer_t)*upd.size());
+    std::unique_ptr<FrontalMatrixDense<scalar_t,integer_t>> front
+      (new FrontalMatrixDense<scalar_t,integer_t>
+       (hdr[0], hdr[1], hdr[2], upd));
+    front->read_factors(is);
+    if (!is.good()) return nullptr;
+    nr_fronts_.dense++;
+    if (hdr[4]) {
+      auto ch = read_front(is);
+      if (!ch) return nullptr;
+      front->set_lchild(std::move(ch));
+    }
+    if (hdr[5]) {
+      auto ch = read_front(is);
+      if (!ch) return nullptr;
+      front->set_rchild(std::move(ch));
+    }
+    return std::move(front);
+  }
+
   template<typename scalar_t,typename integer_t> void
   EliminationTree<scalar_t,integer_t>::draw
   (const SpMat_t& A, const std::string& name) const {
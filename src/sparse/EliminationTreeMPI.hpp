@@ -67,6 +67,8 @@ namespace strumpack {
     integer_t maximum_rank() const override;
     long long factor_nonzeros() const override;
     long long dense_factor_nonzeros() const override;
+    long long dense_peak_memory
+    (const SPOptions<scalar_t>& opts) const override;
 
   protected:
     const MPIComm& comm_;
@@ -98,7 +100,8 @@ namespace strumpack {
     integer_t active_pfronts_;
 
     void symbolic_factorization
-    (const SpMat_t& A, const Tree_t& tree, integer_t sep,
+    (const SPOptions<scalar_t>& opts, const SpMat_t& A,
+     const Tree_t& tree, integer_t sep,
      std::vector<std::vector<integer_t>>& upd,
      std::vector<float>& subtree_work, int depth=0) const;
 
@@ -130,7 +133,7 @@ namespace strumpack {
     std::vector<float> subtree_work(tree.separators());
 #pragma omp parallel default(shared)
 #pragma omp single
-    symbolic_factorization(A, tree, tree.root(), upd, subtree_work);
+    symbolic_factorization(opts, A, tree, tree.root(), upd, subtree_work);
     local_range_ = {A.size(), 0};
     this->root_ = proportional_mapping
       (tree, opts, upd, subtree_work, tree.root(),
@@ -203,7 +206,8 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> void
   EliminationTreeMPI<scalar_t,integer_t>::symbolic_factorization
-  (const SpMat_t& A, const Tree_t& tree, const integer_t sep,
+  (const SPOptions<scalar_t>& opts, const SpMat_t& A,
+   const Tree_t& tree, const integer_t sep,
    std::vector<std::vector<integer_t>>& upd,
    std::vector<float>& subtree_work, int depth) const {
     auto chl = tree.lch(sep);
@@ -212,17 +216,21 @@ namespace strumpack {
       if (chl != -1)
 #pragma omp task untied default(shared)                                 \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
-        symbolic_factorization(A, tree, chl, upd, subtree_work, depth+1);
+        symbolic_factorization
+          (opts, A, tree, chl, upd, subtree_work, depth+1);
       if (chr != -1)
 #pragma omp task untied default(shared)                                 \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
-        symbolic_factorization(A, tree, chr, upd, subtree_work, depth+1);
+        symbolic_factorization
+          (opts, A, tree, chr, upd, subtree_work, depth+1);
 #pragma omp taskwait
     } else {
       if (chl != -1)
-        symbolic_factorization(A, tree, chl, upd, subtree_work, depth);
+        symbolic_factorization
+          (opts, A, tree, chl, upd, subtree_work, depth);
       if (chr != -1)
-        symbolic_factorization(A, tree, chr, upd, subtree_work, depth);
+        symbolic_factorization
+          (opts, A, tree, chr, upd, subtree_work, depth);
     }
     auto sep_begin = tree.sizes(sep);
     auto sep_end = tree.sizes(sep+1);
@@ -259,12 +267,13 @@ namespace strumpack {
           (std::unique(upd[sep].begin(), upd[sep].end()), upd[sep].end());
       }
     }
-    integer_t dim_blk = (sep_end - sep_begin) + upd[sep].size();
-    // assume amount of work per front is N^3, work per subtree is
-    // work on front plus children
+    // work per subtree is the estimated work for the front, which
+    // depends on the front type, plus the work for the children. The
+    // parent is not known yet, assume it will be compressed.
     float wl = (chl != -1) ? subtree_work[chl] : 0.;
     float wr = (chr != -1) ? subtree_work[chr] : 0.;
-    subtree_work[sep] = (float(dim_blk)*dim_blk*dim_blk) + wl + wr;
+    subtree_work[sep] = front_work_estimate
+      (sep_end - sep_begin, upd[sep].size(), true, opts) + wl + wr;
   }
 
   // keep track of [P0_pa, P0_pa+P_pa) -> can be used to stop iso keep_subtree
@@ -351,6 +360,13 @@ namespace strumpack {
       (EliminationTree<scalar_t,integer_t>::dense_factor_nonzeros(), MPI_SUM);
   }
 
+  template<typename scalar_t,typename integer_t> long long
+  EliminationTreeMPI<scalar_t,integer_t>::dense_peak_memory
+  (const SPOptions<scalar_t>& opts) const {
+    return comm_.all_reduce
+      (EliminationTree<scalar_t,integer_t>::dense_peak_memory(opts), MPI_MAX);
+  }
+
 } // end namespace strumpack
 
 #endif
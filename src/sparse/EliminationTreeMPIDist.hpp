@@ -30,6 +30,7 @@
 #define ELIMINATION_TREE_MPI_DIST_HPP
 
 #include <iostream>
+#include <iomanip>
 #include <algorithm>
 #include <random>
 
@@ -72,6 +73,9 @@ namespace strumpack {
     void separator_reordering
     (const Opts_t& opts, const CSRMatrixMPI<scalar_t,integer_t>& A);
 
+    void update_values
+    (const Opts_t& opts, const CSRMatrixMPI<scalar_t,integer_t>& A);
+
   private:
     using EliminationTreeMPI<scalar_t,integer_t>::comm_;
     using EliminationTreeMPI<scalar_t,integer_t>::rank_;
@@ -114,13 +118,26 @@ namespace strumpack {
     /** all parallel fronts on which this process is active. */
     std::vector<ParallelFront> local_pfronts_;
 
+    /**
+     * The distributed front that is the parent of the local subtree
+     * of this process, and the estimated work for that local subtree,
+     * used to compare the predicted and measured factorization time.
+     */
+    const FMPI_t* local_subtree_parent_ = nullptr;
+    float local_subtree_work_ = 0.;
+    void set_local_subtree
+    (const std::unique_ptr<F_t>& front, int P0, int P, int Pl, int Pr,
+     float wl, float wr);
+    void print_subtree_timings(double local_time) const;
+
     void symbolic_factorization
-    (std::vector<std::vector<integer_t>>& upd,
+    (const Opts_t& opts, std::vector<std::vector<integer_t>>& upd,
      std::vector<integer_t>& dist_upd,
      std::vector<float>& subtree_work, float& dsep_work);
 
     void symbolic_factorization_local
-    (integer_t sep, std::vector<std::vector<integer_t>>& upd,
+    (const Opts_t& opts, integer_t sep,
+     std::vector<std::vector<integer_t>>& upd,
      std::vector<float>& subtree_work, int depth);
 
     std::unique_ptr<F_t> proportional_mapping
@@ -158,7 +175,7 @@ namespace strumpack {
 
     float dsep_work;
     MPIComm::control_start("symbolic_factorization");
-    symbolic_factorization(lupd, dupd, ltree_work, dsep_work);
+    symbolic_factorization(opts, lupd, dupd, ltree_work, dsep_work);
     MPIComm::control_stop("symbolic_factorization");
 
     {// communicate dist_subtree_work to everyone
@@ -180,6 +197,8 @@ namespace strumpack {
     }
 
     local_range_ = {A.size(), 0};
+    // with a single process, everything is the local subtree
+    if (P_ == 1) local_subtree_work_ = dtree_work[nd_.tree().root()];
     MPIComm::control_start("proportional_mapping");
     this->root_ = proportional_mapping
       (opts, lupd, dupd, ltree_work, dtree_work,
@@ -218,6 +237,20 @@ namespace strumpack {
     //    HODLR::CompressionAlgorithm::RANDOM_SAMPLING));
   }
 
+  /**
+   * Redistribute the values of a new matrix A, with the same sparsity
+   * pattern as the matrix used to construct this tree, to the
+   * proportionally mapped sparse matrix. The reordering and the
+   * symbolic factorization are not recomputed.
+   */
+  template<typename scalar_t,typename integer_t> void
+  EliminationTreeMPIDist<scalar_t,integer_t>::update_values
+  (const Opts_t& opts, const CSRMatrixMPI<scalar_t,integer_t>& A) {
+    Aprop_ = PropMapSparseMatrix<scalar_t,integer_t>();
+    Aprop_.setup
+      (A, nd_, *this, opts.compression() != CompressionType::NONE);
+  }
+
   /**
    * Figure out on which processor element i,j of the sparse matrix
    * (after symmetric nested dissection permutation) is mapped.  Since
@@ -354,7 +387,61 @@ namespace strumpack {
   EliminationTreeMPIDist<scalar_t,integer_t>::multifrontal_factorization
   (const CompressedSparseMatrix<scalar_t,integer_t>& A,
    const Opts_t& opts) {
+    TaskTimer t("");
+    t.start();
     this->root_->multifrontal_factorization(Aprop_, opts);
+    if (opts.verbose())
+      print_subtree_timings
+        (local_subtree_parent_ ? local_subtree_parent_->local_subtree_time()
+         : t.elapsed());
+  }
+
+  /**
+   * Gather the predicted work and the measured factorization time of
+   * the local subtree of each process, and print them on the root.
+   * The predicted work is converted to time using the overall rate,
+   * sum(measured) / sum(predicted), so the imbalance of the two can
+   * be compared directly.
+   */
+  template<typename scalar_t,typename integer_t> void
+  EliminationTreeMPIDist<scalar_t,integer_t>::print_subtree_timings
+  (double local_time) const {
+    std::vector<double> buf(2*P_);
+    buf[2*rank_] = local_subtree_work_;
+    buf[2*rank_+1] = local_time;
+    MPI_Allgather
+      (MPI_IN_PLACE, 2, MPI_DOUBLE, buf.data(), 2, MPI_DOUBLE, comm_.comm());
+    if (!comm_.is_root()) return;
+    double wsum = 0., tsum = 0., wmax = 0., tmax = 0.;
+    for (int p=0; p<P_; p++) {
+      wsum += buf[2*p];  wmax = std::max(wmax, buf[2*p]);
+      tsum += buf[2*p+1];  tmax = std::max(tmax, buf[2*p+1]);
+    }
+    double rate = (wsum > 0.) ? tsum / wsum : 0.;
+    std::cout << "# local subtree factorization, predicted vs measured:"
+              << std::endl;
+    if (P_ <= 64) {
+      std::cout << "#   rank   predicted(s)   measured(s)" << std::endl;
+      for (int p=0; p<P_; p++)
+        std::cout << "#   " << std::setw(4) << p << "   "
+                  << std::setw(12) << buf[2*p] * rate << "   "
+                  << std::setw(11) << buf[2*p+1] << std::endl;
+    }
+    if (wsum > 0. && tsum > 0.)
+      std::cout << "#   imbalance (max/avg): predicted = "
+                << wmax * P_ / wsum << ", measured = "
+                << tmax * P_ / tsum << std::endl;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  EliminationTreeMPIDist<scalar_t,integer_t>::set_local_subtree
+  (const std::unique_ptr<F_t>& front, int P0, int P, int Pl, int Pr,
+   float wl, float wr) {
+    if (P < 2 || !front) return;
+    if (Pl == 1 && rank_ == P0) local_subtree_work_ = wl;
+    else if (Pr == 1 && rank_ == P0+P-Pr) local_subtree_work_ = wr;
+    else return;
+    local_subtree_parent_ = static_cast<const FMPI_t*>(front.get());
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -520,7 +607,8 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> void
   EliminationTreeMPIDist<scalar_t,integer_t>::symbolic_factorization_local
-  (integer_t sep, std::vector<std::vector<integer_t>>& upd,
+  (const Opts_t& opts, integer_t sep,
+   std::vector<std::vector<integer_t>>& upd,
    std::vector<float>& subtree_work, int depth) {
     auto chl = nd_.local_tree().lch(sep);
     auto chr = nd_.local_tree().rch(sep);
@@ -528,17 +616,21 @@ namespace strumpack {
       if (chl != -1)
 #pragma omp task untied default(shared)                                 \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
-        symbolic_factorization_local(chl, upd, subtree_work, depth+1);
+        symbolic_factorization_local
+          (opts, chl, upd, subtree_work, depth+1);
       if (chr != -1)
 #pragma omp task untied default(shared)                                 \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
-        symbolic_factorization_local(chr, upd, subtree_work, depth+1);
+        symbolic_factorization_local
+          (opts, chr, upd, subtree_work, depth+1);
 #pragma omp taskwait
     } else {
       if (chl != -1)
-        symbolic_factorization_local(chl, upd, subtree_work, depth);
+        symbolic_factorization_local
+          (opts, chl, upd, subtree_work, depth);
       if (chr != -1)
-        symbolic_factorization_local(chr, upd, subtree_work, depth);
+        symbolic_factorization_local
+          (opts, chr, upd, subtree_work, depth);
     }
     auto sep_begin = nd_.local_tree().sizes(sep) +
       nd_.sub_graph_range.first;
@@ -575,12 +667,13 @@ namespace strumpack {
         (std::unique(upd[sep].begin(), upd[sep].end()), upd[sep].end());
     }
     upd[sep].shrink_to_fit();
-    integer_t dim_blk = (sep_end - sep_begin) + upd[sep].size();
-    // assume amount of work per front is N^3, work per subtree is
-    // work on front plus children
+    // work per subtree is the estimated work for the front, which
+    // depends on the front type, plus the work for the children. The
+    // parent is not known yet, assume it will be compressed.
     float wl = (chl != -1) ? subtree_work[chl] : 0.;
     float wr = (chr != -1) ? subtree_work[chr] : 0.;
-    subtree_work[sep] = (float(dim_blk)*dim_blk*dim_blk) + wl + wr;
+    subtree_work[sep] = front_work_estimate
+      (sep_end - sep_begin, upd[sep].size(), true, opts) + wl + wr;
   }
 
   /**
@@ -594,13 +687,13 @@ namespace strumpack {
    *        childs, merge with upd for local distributed separator
    *        send upd to parent receive work estimate from left and
    *        right subtrees work estimate for distributed separator
-   *        subtree is dim_blk^3 + left_tree + right_tree send work
-   *        estimate for this distributed separator / subtree to
-   *        parent
+   *        subtree is front_work_estimate + left_tree + right_tree
+   *        send work estimate for this distributed separator /
+   *        subtree to parent
    */
   template<typename scalar_t,typename integer_t> void
   EliminationTreeMPIDist<scalar_t,integer_t>::symbolic_factorization
-  (std::vector<std::vector<integer_t>>& local_upd,
+  (const Opts_t& opts, std::vector<std::vector<integer_t>>& local_upd,
    std::vector<integer_t>& dist_upd, std::vector<float>& local_subtree_work,
    float& dsep_work) {
     nd_.my_sub_graph.sort_rows();
@@ -608,7 +701,7 @@ namespace strumpack {
 #pragma omp parallel
 #pragma omp single
       symbolic_factorization_local
-        (nd_.local_tree().root(), local_upd, local_subtree_work, 0);
+        (opts, nd_.local_tree().root(), local_upd, local_subtree_work, 0);
     }
 
     /* initialize dsep_work so valgrind does not complain, as it is
@@ -700,9 +793,9 @@ namespace strumpack {
         float dsep_left_work, dsep_right_work;
         MPI_Recv(&dsep_left_work,  1, MPI_FLOAT, chl, 3, comm_.comm(), &stat);
         MPI_Recv(&dsep_right_work, 1, MPI_FLOAT, chr, 4, comm_.comm(), &stat);
-        integer_t dim_blk = (sep_end - sep_begin) + dist_upd.size();
-        dsep_work = (float(dim_blk)*dim_blk*dim_blk) + dsep_left_work +
-          dsep_right_work;
+        dsep_work = front_work_estimate
+          (sep_end - sep_begin, dist_upd.size(), true, opts) +
+          dsep_left_work + dsep_right_work;
 
         // send dist_upd and work estimate to parent
         if (nd_.tree().pa(pa) != -1) {
@@ -853,6 +946,7 @@ namespace strumpack {
     auto wr = dist_subtree_work[chr];
     int Pl = std::max(1, std::min(int(std::round(P * wl / (wl + wr))), P-1));
     int Pr = std::max(1, P - Pl);
+    set_local_subtree(front, P0, P, Pl, Pr, wl, wr);
     auto lch = proportional_mapping
       (opts, local_upd, dist_upd, local_subtree_work, dist_subtree_work,
        chl, P0, Pl, P0+P-Pr, Pr, fcomm.sub(0, Pl), use_compression, level+1);
@@ -911,6 +1005,7 @@ namespace strumpack {
       int Pl = std::max
         (1, std::min(int(std::round(P * wl / (wl + wr))), P-1));
       int Pr = std::max(1, P - Pl);
+      set_local_subtree(front, P0, P, Pl, Pr, wl, wr);
       bool use_compression = is_compressed
         (dim_sep, dim_upd, parent_compression, opts);
       front->set_lchild
@@ -305,7 +305,213 @@ namespace strumpack {
     }
 
 
+    //////////////////////////////////////////////////////////////
+    ////// packed point-to-point extend-add //////////////////////
+    //////////////////////////////////////////////////////////////
+    /**
+     * Destination of each row/column of a contribution block in the
+     * 2D block cyclic grid of the parent, pr[r] + pc[c] * prows, and
+     * the index of each row/column among the rows/columns with the
+     * same destination in the same part (parent separator or parent
+     * update). With this, the position of every element in the send
+     * buffer follows directly, without the push_back of
+     * extend_add_copy_to_buffers, so packing can be done in
+     * parallel, in a single pass.
+     */
+    struct PackMap {
+      std::vector<int> pr, pc;
+      std::vector<std::size_t> ri, ci, nr1, nr2, nc1, nc2;
+      int r_upd, c_upd, prows;
+    };
+
+    static void extend_add_send_counts
+    (const DistM_t& CB, std::size_t* cnt,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa,
+     const std::vector<std::size_t>& I) {
+      if (!CB.active()) return;
+      assert(CB.fixed());
+      send_counts
+        (pack_map(CB.lrows(), CB.lcols(),
+                  [&](int r) { return I[CB.rowl2g_fixed(r)]; },
+                  [&](int c) { return I[CB.coll2g_fixed(c)]; }, pa), cnt);
+    }
+    static void extend_add_seq_send_counts
+    (const DenseM_t& CB, std::size_t* cnt,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa,
+     const FrontalMatrix<scalar_t,integer_t>* ch) {
+      const auto I = ch->upd_to_parent
+        (static_cast<const FrontalMatrix<scalar_t,integer_t>*>(pa));
+      auto g = [&](int i) { return I[i]; };
+      send_counts(pack_map(CB.rows(), CB.cols(), g, g, pa), cnt);
+    }
+
+    /**
+     * Pack the local part of the contribution block in sbuf, with the
+     * elements for process p of the parent starting at sbuf+pos[p],
+     * in the same order as extend_add_copy_to_buffers.
+     */
+    static void extend_add_pack
+    (const DistM_t& CB, scalar_t* sbuf, const std::size_t* pos,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa,
+     const std::vector<std::size_t>& I) {
+      if (!CB.active()) return;
+      assert(CB.fixed());
+      pack(CB, pack_map(CB.lrows(), CB.lcols(),
+                        [&](int r) { return I[CB.rowl2g_fixed(r)]; },
+                        [&](int c) { return I[CB.coll2g_fixed(c)]; }, pa),
+           sbuf, pos);
+    }
+    static void extend_add_seq_pack
+    (const DenseM_t& CB, scalar_t* sbuf, const std::size_t* pos,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa,
+     const FrontalMatrix<scalar_t,integer_t>* ch) {
+      const auto I = ch->upd_to_parent
+        (static_cast<const FrontalMatrix<scalar_t,integer_t>*>(pa));
+      auto g = [&](int i) { return I[i]; };
+      pack(CB, pack_map(CB.rows(), CB.cols(), g, g, pa), sbuf, pos);
+    }
+
+    /**
+     * Add to cnt[p] the number of elements that this process will
+     * receive from process p of the child ch (p relative to the
+     * master of ch), in extend_add_copy_from_buffers. This only
+     * depends on the symbolic data and the process grids.
+     */
+    static void extend_add_recv_counts
+    (const DistM_t& F11, const DistM_t& F22, std::size_t* cnt,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa,
+     const FrontalMatrixMPI<scalar_t,integer_t>* ch) {
+      std::vector<std::size_t> ur, uc;
+      matched_rows_cols(F11, F22, pa, ch, ur, uc);
+      const auto prows = ch->grid()->nprows();
+      const auto pcols = ch->grid()->npcols();
+      const auto B = DistM_t::default_MB;
+      std::vector<std::size_t> nr(prows), nc(pcols);
+      for (auto r : ur) nr[(r / B) % prows]++;
+      for (auto c : uc) nc[(c / B) % pcols]++;
+      for (int pc=0; pc<pcols; pc++)
+        for (int pr=0; pr<prows; pr++)
+          cnt[pr+pc*prows] += nr[pr] * nc[pc];
+    }
+    static void extend_add_seq_recv_counts
+    (const DistM_t& F11, const DistM_t& F22, std::size_t* cnt,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa,
+     const FrontalMatrix<scalar_t,integer_t>* ch) {
+      std::vector<std::size_t> ur, uc;
+      matched_rows_cols(F11, F22, pa, ch, ur, uc);
+      cnt[0] += ur.size() * uc.size();
+    }
+
+  private:
+    template<typename RowG, typename ColG> static PackMap pack_map
+    (int rows, int cols, RowG rowg, ColG colg,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa) {
+      const std::size_t pa_sep = pa->dim_sep();
+      const auto prows = pa->grid()->nprows();
+      const auto pcols = pa->grid()->npcols();
+      const auto B = DistM_t::default_MB;
+      PackMap m;
+      m.prows = prows;
+      m.pr.resize(rows);  m.ri.resize(rows);
+      m.pc.resize(cols);  m.ci.resize(cols);
+      m.nr1.assign(prows, 0);  m.nr2.assign(prows, 0);
+      m.nc1.assign(pcols, 0);  m.nc2.assign(pcols, 0);
+      m.r_upd = rows;
+      for (int r=0; r<rows; r++) {
+        std::size_t t = rowg(r);
+        if (t < pa_sep) {
+          m.pr[r] = (t / B) % prows;
+          m.ri[r] = m.nr1[m.pr[r]]++;
+        } else {
+          if (m.r_upd == rows) m.r_upd = r;
+          m.pr[r] = ((t - pa_sep) / B) % prows;
+          m.ri[r] = m.nr2[m.pr[r]]++;
+        }
+      }
+      m.c_upd = cols;
+      for (int c=0; c<cols; c++) {
+        std::size_t t = colg(c);
+        if (t < pa_sep) {
+          m.pc[c] = (t / B) % pcols;
+          m.ci[c] = m.nc1[m.pc[c]]++;
+        } else {
+          if (m.c_upd == cols) m.c_upd = c;
+          m.pc[c] = ((t - pa_sep) / B) % pcols;
+          m.ci[c] = m.nc2[m.pc[c]]++;
+        }
+      }
+      return m;
+    }
+
+    static void send_counts(const PackMap& m, std::size_t* cnt) {
+      for (std::size_t pc=0; pc<m.nc1.size(); pc++)
+        for (std::size_t pr=0; pr<m.nr1.size(); pr++)
+          cnt[pr+pc*m.prows] +=
+            (m.nr1[pr] + m.nr2[pr]) * (m.nc1[pc] + m.nc2[pc]);
+    }
+
+    template<typename CB_t> static void pack
+    (const CB_t& CB, const PackMap& m, scalar_t* sbuf,
+     const std::size_t* pos) {
+      const int rows = m.pr.size(), cols = m.pc.size();
+      // for destination (pr,pc), the elements are ordered as the
+      // F11, F12, F21 and F22 parts, each stored column major
+#pragma omp parallel for
+      for (int c=0; c<cols; c++) {
+        const auto pc = m.pc[c];
+        const bool c2 = c >= m.c_upd;
+        const auto nc1 = m.nc1[pc], nc = nc1 + m.nc2[pc];
+        for (int r=0; r<m.r_upd; r++) { // F11, F12
+          const auto pr = m.pr[r];
+          const auto n1 = m.nr1[pr];
+          sbuf[pos[pr+pc*m.prows] + (c2 ? n1*nc1 : 0) +
+               m.ci[c]*n1 + m.ri[r]] = CB(r,c);
+        }
+        for (int r=m.r_upd; r<rows; r++) { // F21, F22
+          const auto pr = m.pr[r];
+          const auto n2 = m.nr2[pr];
+          sbuf[pos[pr+pc*m.prows] + m.nr1[pr]*nc + (c2 ? n2*nc1 : 0) +
+               m.ci[c]*n2 + m.ri[r]] = CB(r,c);
+        }
+      }
+    }
+
+    /**
+     * Positions in the update of ch of the rows and columns of the
+     * local part of the parent front that receive contributions from
+     * ch, for the F11 and then the F22 rows/columns, as in
+     * extend_add_copy_from_buffers.
+     */
+    static void matched_rows_cols
+    (const DistM_t& F11, const DistM_t& F22,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa,
+     const FrontalMatrix<scalar_t,integer_t>* ch,
+     std::vector<std::size_t>& ur, std::vector<std::size_t>& uc) {
+      if (!(F11.active() || F22.active())) return;
+      const std::size_t ch_dim_upd = ch->dim_upd();
+      const auto ch_upd = ch->upd();
+      const auto pa_upd = pa->upd();
+      const auto pa_sep = pa->sep_begin();
+      auto match = [&](int n, std::vector<std::size_t>& u, bool sep,
+                       auto l2g) {
+        for (std::size_t i=0, iu=0; i<std::size_t(n); i++) {
+          std::size_t fg = sep ? l2g(i) + pa_sep : pa_upd[l2g(i)];
+          while (iu < ch_dim_upd && std::size_t(ch_upd[iu]) < fg) iu++;
+          if (iu == ch_dim_upd) break;
+          if (std::size_t(ch_upd[iu]) == fg) u.push_back(iu);
+        }
+      };
+      match(F11.lrows(), ur, true,
+            [&](int r) { return F11.rowl2g_fixed(r); });
+      match(F22.lrows(), ur, false,
+            [&](int r) { return F22.rowl2g_fixed(r); });
+      match(F11.lcols(), uc, true,
+            [&](int c) { return F11.coll2g_fixed(c); });
+      match(F22.lcols(), uc, false,
+            [&](int c) { return F22.coll2g_fixed(c); });
+    }
 
+  public:
 
     //////////////////////////////////////////////////////////////
     ////// 1D extend-add for the right-hand side /////////////////
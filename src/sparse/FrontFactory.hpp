@@ -31,6 +31,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include "CSRGraph.hpp"
 #include "FrontalMatrixDense.hpp"
 #include "FrontalMatrixHSS.hpp"
@@ -72,7 +73,9 @@ namespace strumpack {
   template<typename scalar_t> bool is_CUBLAS
   (const SPOptions<scalar_t>& opts) {
 #if defined(STRUMPACK_USE_CUBLAS)
-    return opts.use_gpu() && opts.compression() == CompressionType::NONE;
+    // the CUBLAS fronts only implement LU
+    return opts.use_gpu() && opts.compression() == CompressionType::NONE &&
+      opts.factorization() == FactorizationType::LU;
 #else
     return false;
 #endif
@@ -123,6 +126,60 @@ namespace strumpack {
        is_lossy(dsep, dupd, compressed_parent, opts));
   }
 
+  /**
+   * Estimate the cost of the factorization of a front with separator
+   * size dsep and update size dupd, in flops, from the symbolic
+   * data only. The estimate depends on the type of front that
+   * create_frontal_matrix will use for these sizes:
+   *  - dense: 2/3 dsep^3 + 2 dsep^2 dupd + 2 dsep dupd^2 (halved for
+   *    Cholesky)
+   *  - BLR: the dense flops, scaled by 2r/b for the low-rank tile
+   *    products, plus compression of all tiles and the dense LU of
+   *    the diagonal tiles, with b the BLR leaf size
+   *  - HSS: random sampling, 2 n^2 r, plus compression and ULV
+   *    factorization, 10 n r^2, with n = dsep + dupd
+   *  - HODLR: construction and factorization, 4 n r^2 log^2(n/leaf)
+   *  - lossy: as dense
+   * Ranks are not known before the factorization, so r is taken as
+   * the square root of the size of the compressed blocks (n, or b
+   * for BLR tiles), capped by the maximum rank from the options. To
+   * account for the extend-add, which is bandwidth and not compute
+   * bound, each word of the contribution block sent to the parent
+   * counts as ea_word_cost flops.
+   */
+  template<typename scalar_t> float front_work_estimate
+  (std::size_t dsep, std::size_t dupd, bool compressed_parent,
+   const SPOptions<scalar_t>& opts, float ea_word_cost=8.f) {
+    double s = dsep, u = dupd, n = s + u;
+    double dense = 2./3.*s*s*s + 2.*s*s*u + 2.*s*u*u;
+    if (opts.factorization() == FactorizationType::CHOLESKY)
+      dense /= 2.;
+    double ea = u * u, w = dense;
+    auto rank = [](double m, int max_rank) {
+      return std::max(1., std::min(double(max_rank), std::sqrt(m)));
+    };
+    if (is_HSS(dsep, dupd, compressed_parent, opts)) {
+      double r = rank(n, opts.HSS_options().max_rank());
+      w = 2. * n * n * r + 10. * n * r * r;
+      ea = u * r;
+    } else if (is_BLR(dsep, dupd, compressed_parent, opts)) {
+      double b = std::max(1, opts.BLR_options().leaf_size()),
+        r = rank(b, opts.BLR_options().max_rank());
+      w = dense * std::min(1., 2. * r / b) + 4. * n * n * r +
+        2./3. * s * b * b;
+    }
+#if defined(STRUMPACK_USE_BPACK)
+    else if (is_HODLR(dsep, dupd, compressed_parent, opts)) {
+      double r = rank(n, opts.HODLR_options().max_rank()),
+        L = std::max
+        (1., std::log2(n / std::max(1, opts.HODLR_options().leaf_size())));
+      w = 4. * n * r * r * L * L;
+      ea = u * r;
+    }
+#endif
+    return float(w + ea_word_cost * ea);
+  }
+
   template<typename scalar_t, typename integer_t>
   std::unique_ptr<FrontalMatrix<scalar_t,integer_t>> create_frontal_matrix
   (const SPOptions<scalar_t>& opts, integer_t s, integer_t sbegin,
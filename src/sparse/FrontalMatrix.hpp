@@ -147,11 +147,35 @@ namespace strumpack {
     virtual integer_t maximum_rank(int task_depth=0) const { return 0; }
     virtual long long factor_nonzeros(int task_depth=0) const;
     virtual long long dense_factor_nonzeros(int task_depth=0) const;
+
+    /**
+     * Predict the peak memory (number of scalars) used by the
+     * factorization of this subtree, assuming all fronts are dense,
+     * for the traversal used in the factorization: the children of
+     * fronts above the task recursion cutoff level are factored
+     * concurrently, subtrees of small fronts level by level (see
+     * SPOptions::batch_cutoff), and the remaining subtrees
+     * sequentially in postorder, with the contribution blocks on a
+     * stack (see SPOptions::use_CB_workspace).
+     *
+     * \param opts the options used for the factorization
+     * \param after on output, the memory still in use after the
+     * subtree has been factored, ie, the factors and the contribution
+     * block of this front
+     * \param task_depth current depth in the task recursion tree
+     */
+    virtual long long dense_peak_memory
+    (const Opts_t& opts, long long& after, int task_depth=0) const;
     virtual bool isHSS() const { return false; }
     virtual bool isMPI() const { return false; }
     virtual void print_rank_statistics(std::ostream &out) const {}
     virtual std::string type() const { return "FrontalMatrix"; }
 
+    // write the structure and the factors of this subtree, in
+    // preorder, returns false if a front type does not support this
+    // (see write_factors), EliminationTree::read_factors reads this
+    bool write(std::ostream& os) const;
+
     virtual void partition_fronts
     (const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
      bool is_root=true, int task_depth=0);
@@ -177,6 +201,38 @@ namespace strumpack {
       return max_dupd;
     }
 
+    /**
+     * Check whether all fronts in this subtree are dense (and not
+     * lossy) fronts smaller than cutoff, ie, whether the subtree can
+     * be factored level by level.
+     */
+    bool small_dense_subtree(integer_t cutoff) const {
+      if (dim_blk() >= cutoff || type() != "FrontalMatrixDense")
+        return false;
+      return (!lchild_ || lchild_->small_dense_subtree(cutoff)) &&
+        (!rchild_ || rchild_->small_dense_subtree(cutoff));
+    }
+
+    /**
+     * Number of scalars needed to store the contribution blocks of
+     * the fronts in this subtree on a stack (see CBWorkspace), during
+     * a postorder traversal. This only depends on the symbolic
+     * factorization.
+     *
+     * \param own include the contribution block of this front
+     */
+    std::size_t CB_workspace_size(bool own=true) const {
+      std::size_t peak = 0, cbs = 0;
+      for (auto ch : {lchild_.get(), rchild_.get()}) {
+        if (!ch) continue;
+        peak = std::max(peak, cbs + ch->CB_workspace_size());
+        std::size_t dupd = ch->dim_upd();
+        cbs += dupd * dupd;
+      }
+      std::size_t dupd = own ? dim_upd() : 0;
+      return std::max(peak, cbs + dupd * dupd);
+    }
+
     virtual int P() const { return 1; }
 
     void get_level_fronts(std::vector<const F_t*>& ldata, int elvl, int l=0) const;
@@ -213,6 +269,28 @@ namespace strumpack {
       ExtAdd::extend_add_seq_copy_from_buffers
         (F11, F12, F21, F22, *pbuf, pa, this);
     }
+    /**
+     * Packed, point-to-point extend-add, see
+     * FrontalMatrixDenseMPI::extend_add. This is only supported by
+     * fronts that return true from packed_extend_add().
+     * extend_add_send_counts adds the number of elements this process
+     * sends to each process of the parent pa, extend_add_pack writes
+     * them to sbuf, starting at sbuf+pos[p] for process p of the
+     * parent, and extend_add_recv_counts adds the number of elements
+     * each process of the parent receives from this front.
+     */
+    virtual bool packed_extend_add() const { return false; }
+    virtual void extend_add_send_counts
+    (std::size_t* cnt, const FMPI_t* pa) const {}
+    virtual void extend_add_pack
+    (scalar_t* sbuf, const std::size_t* pos, const FMPI_t* pa) const {}
+    virtual void extend_add_recv_counts
+    (const DistM_t& F11, const DistM_t& F22,
+     std::size_t* cnt, const FMPI_t* pa) const {
+      ExtAdd::extend_add_seq_recv_counts
+        (F11, F22, cnt+pa->master(this), pa, this);
+    }
+
     virtual void extend_add_column_copy_to_buffers
     (const DistM_t& CB, const DenseM_t& seqCB,
      std::vector<std::vector<scalar_t>>& sbuf, const FMPI_t* pa) const {
@@ -276,6 +354,8 @@ namespace strumpack {
       return dense_node_factor_nonzeros();
     }
 
+    virtual bool write_factors(std::ostream& os) const { return false; }
+
     virtual void partition
     (const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
      bool is_root=true, int task_depth=0);
@@ -301,6 +381,19 @@ namespace strumpack {
       upd_(std::move(upd)), lchild_(lchild), rchild_(rchild) {
   }
 
+  template<typename scalar_t,typename integer_t> bool
+  FrontalMatrix<scalar_t,integer_t>::write(std::ostream& os) const {
+    std::int64_t hdr[6] = {sep_, sep_begin_, sep_end_,
+                           std::int64_t(upd_.size()),
+                           lchild_ != nullptr, rchild_ != nullptr};
+    os.write((const char*)hdr, sizeof(hdr));
+    os.write((const char*)upd_.data(), sizeof(integer_t)*upd_.size());
+    if (!write_factors(os)) return false;
+    if (lchild_ && !lchild_->write(os)) return false;
+    if (rchild_ && !rchild_->write(os)) return false;
+    return os.good();
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontalMatrix<scalar_t,integer_t>::draw
   (std::ostream& of, int etree_level) const {
@@ -560,6 +653,54 @@ namespace strumpack {
     return nnz + nnzl + nnzr;
   }
 
+  template<typename scalar_t,typename integer_t> long long
+  FrontalMatrix<scalar_t,integer_t>::dense_peak_memory
+  (const Opts_t& opts, long long& after, int task_depth) const {
+    const bool chol = opts.factorization() == FactorizationType::CHOLESKY;
+    // F11, F12 and F21, F12 is not stored for Cholesky
+    auto factors = [chol](const F_t* f) {
+      long long dsep = f->dim_sep(), dupd = f->dim_upd();
+      return dsep * (dsep + (chol ? 1 : 2) * dupd);
+    };
+    auto CB = [](const F_t* f) {
+      long long dupd = f ? f->dim_upd() : 0;
+      return dupd * dupd;
+    };
+    if (small_dense_subtree(opts.batch_cutoff())) {
+      // level by level, all fronts on a level are built at once,
+      // while the CBs of the previous level are still alive
+      long long done = 0, cbs = 0, peak = 0;
+      std::vector<const F_t*> fp;
+      for (int l=levels()-1; l>=0; l--) {
+        fp.clear();
+        get_level_fronts(fp, l);
+        long long fl = 0, cbl = 0;
+        for (auto f : fp) {
+          fl += factors(f);
+          cbl += CB(f);
+        }
+        peak = std::max(peak, done + cbs + fl + cbl);
+        done += fl;
+        cbs = cbl;
+      }
+      after = done + cbs;
+      return peak;
+    }
+    const bool par = task_depth < params::task_recursion_cutoff_level;
+    const int td = par ? task_depth+1 : task_depth;
+    long long al = 0, ar = 0, pl = 0, pr = 0;
+    if (lchild_) pl = lchild_->dense_peak_memory(opts, al, td);
+    if (rchild_) pr = rchild_->dense_peak_memory(opts, ar, td);
+    // the front is allocated while the children CBs are alive
+    long long front = al + ar + factors(this) + CB(this);
+    after = front - CB(lchild_.get()) - CB(rchild_.get());
+    if (par) return std::max(pl + pr, front);
+    if (opts.use_CB_workspace() && type() == "FrontalMatrixDense")
+      // the stack for the descendants' CBs is allocated up front
+      return CB_workspace_size(false) + after;
+    return std::max(std::max(pl, al + pr), front);
+  }
+
 #if defined(STRUMPACK_USE_MPI)
   template<typename scalar_t,typename integer_t> void
   FrontalMatrix<scalar_t,integer_t>::multifrontal_solve
@@ -32,6 +32,7 @@
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <numeric>
 #include <cmath>
 #include <random>
 
@@ -95,7 +96,10 @@ namespace strumpack {
 #if defined(STRUMPACK_USE_MPI)
     void extend_add_copy_to_buffers
     (std::vector<std::vector<scalar_t>>& sbuf, const FMPI_t* pa) const override {
-      ExtAdd::extend_add_seq_copy_to_buffers(F22_, sbuf, pa, this);
+      if (F22blr_.rows() == std::size_t(dim_upd()))
+        ExtAdd::extend_add_seq_copy_to_buffers
+          (F22blr_.dense(), sbuf, pa, this);
+      else ExtAdd::extend_add_seq_copy_to_buffers(F22_, sbuf, pa, this);
     }
 #endif
 
@@ -113,6 +117,10 @@ namespace strumpack {
     FrontalMatrixBLR(const FrontalMatrixBLR&) = delete;
     FrontalMatrixBLR& operator=(FrontalMatrixBLR const&) = delete;
 
+    void extend_add_compressed_CB
+    (DenseM_t& paF11, DenseM_t& paF12, DenseM_t& paF21, DenseM_t& paF22,
+     const std::vector<std::size_t>& I, std::size_t upd2sep) const;
+
     void fwd_solve_phase2
     (DenseM_t& b, DenseM_t& bupd, int etree_level, int task_depth) const;
     void bwd_solve_phase1
@@ -151,10 +159,13 @@ namespace strumpack {
     const std::size_t dupd = dim_upd();
     std::size_t upd2sep;
     auto I = this->upd_to_parent(p, upd2sep);
-    // if ACA was used, a compressed version of the CB was constructed
-    // in F22blr_, so we need to expand it first into F22_
-    if (F22blr_.rows() == dupd)
-      F22blr_.dense(F22_);
+    // if ACA was used, or with compress_CB, a compressed version of
+    // the CB was constructed in F22blr_, expand it one tile at a time
+    if (F22blr_.rows() == dupd) {
+      extend_add_compressed_CB(paF11, paF12, paF21, paF22, I, upd2sep);
+      release_work_memory();
+      return;
+    }
 #if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
 #pragma omp taskloop default(shared) grainsize(64)      \
   if(task_depth < params::task_recursion_cutoff_level)
@@ -167,8 +178,9 @@ namespace strumpack {
         for (std::size_t r=upd2sep; r<dupd; r++)
           paF21(I[r]-pdsep,pc) += F22_(r,c);
       } else {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF12(I[r],pc-pdsep) += F22_(r, c);
+        if (paF12.cols())
+          for (std::size_t r=0; r<upd2sep; r++)
+            paF12(I[r],pc-pdsep) += F22_(r, c);
         for (std::size_t r=upd2sep; r<dupd; r++)
           paF22(I[r]-pdsep,pc-pdsep) += F22_(r,c);
       }
@@ -178,10 +190,49 @@ namespace strumpack {
     release_work_memory();
   }
 
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixBLR<scalar_t,integer_t>::extend_add_compressed_CB
+  (DenseM_t& paF11, DenseM_t& paF12, DenseM_t& paF21, DenseM_t& paF22,
+   const std::vector<std::size_t>& I, std::size_t upd2sep) const {
+    const std::size_t pdsep = paF11.rows();
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)
+#endif
+    for (std::size_t tj=0; tj<F22blr_.colblocks(); tj++) {
+      const auto c0 = F22blr_.tilecoff(tj);
+      std::vector<std::size_t> lJ(F22blr_.tilecols(tj)), lI;
+      std::iota(lJ.begin(), lJ.end(), c0);
+      for (std::size_t ti=0; ti<F22blr_.rowblocks(); ti++) {
+        const auto r0 = F22blr_.tileroff(ti);
+        lI.resize(F22blr_.tilerows(ti));
+        std::iota(lI.begin(), lI.end(), r0);
+        auto T = F22blr_.extract(lI, lJ);
+        for (std::size_t c=0; c<T.cols(); c++) {
+          auto pc = I[c0+c];
+          for (std::size_t r=0; r<T.rows(); r++) {
+            auto pr = I[r0+r];
+            if (r0+r < upd2sep) {
+              if (pc < pdsep) paF11(pr,pc) += T(r,c);
+              else if (paF12.cols()) paF12(pr,pc-pdsep) += T(r,c);
+            } else {
+              if (pc < pdsep) paF21(pr-pdsep,pc) += T(r,c);
+              else paF22(pr-pdsep,pc-pdsep) += T(r,c);
+            }
+          }
+        }
+      }
+    }
+    const std::size_t dupd = dim_upd();
+    STRUMPACK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
+    STRUMPACK_FULL_RANK_FLOPS((is_complex<scalar_t>()?2:1) * dupd * dupd);
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixBLR<scalar_t,integer_t>::sample_CB
   (const Opts_t& opts, const DenseM_t& R, DenseM_t& Sr,
    DenseM_t& Sc, FrontalMatrix<scalar_t,integer_t>* pa, int task_depth) {
+    if (F22blr_.rows() == std::size_t(dim_upd()))
+      F22_ = F22blr_.dense();
     auto I = this->upd_to_parent(pa);
     auto cR = R.extract_rows(I);
     DenseM_t cS(dim_upd(), R.cols());
@@ -236,8 +287,49 @@ namespace strumpack {
     if (etree_level == 0 && opts.print_root_front_stats()) t.start();
     const auto dsep = dim_sep();
     const auto dupd = dim_upd();
+    auto F22elem = [&](const std::vector<std::size_t>& lI,
+                       const std::vector<std::size_t>& lJ, DenseM_t& B) {
+      B.zero();
+      auto gI = lI; auto gJ = lJ;
+      for (auto& i : gI) i = this->upd_[i];
+      for (auto& j : gJ) j = this->upd_[j];
+      if (lchild_) lchild_->extract_CB_sub_matrix(gI, gJ, B, task_depth);
+      if (rchild_) rchild_->extract_CB_sub_matrix(gI, gJ, B, task_depth);
+    };
     if (opts.BLR_options().low_rank_algorithm() ==
-        BLR::LowRankAlgorithm::RRQR) {
+        BLR::LowRankAlgorithm::RRQR &&
+        opts.BLR_options().compress_CB()) {
+      // Only the parts of the children's CBs corresponding to F11,
+      // F12 and F21 are assembled densely. The CB of this front is
+      // constructed tile by tile, extracting the children's
+      // contributions (which can themselves be compressed), so a
+      // dense F22 is never formed.
+      DenseM_t F11(dsep, dsep), F12(dsep, dupd), F21(dupd, dsep);
+      F11.zero(); F12.zero(); F21.zero();
+      A.extract_front(F11, F12, F21, sep_begin_, sep_end_, this->upd_, task_depth);
+      std::vector<std::size_t> gsep(dsep),
+        gupd(this->upd_.begin(), this->upd_.end());
+      std::iota(gsep.begin(), gsep.end(), sep_begin_);
+      for (auto ch : {lchild_.get(), rchild_.get()}) {
+        if (!ch) continue;
+        ch->extract_CB_sub_matrix(gsep, gsep, F11, task_depth);
+        ch->extract_CB_sub_matrix(gsep, gupd, F12, task_depth);
+        ch->extract_CB_sub_matrix(gupd, gsep, F21, task_depth);
+      }
+      if (dsep) {
+        DenseM_t F22;
+        BLR::BLR_construct_and_partial_factor
+          (F11, F12, F21, F22, F11blr_, piv_, F12blr_, F21blr_,
+           sep_tiles_, upd_tiles_, admissibility_, opts.BLR_options());
+      }
+      if (dupd)
+        BLR::BLR_Schur_complement<scalar_t>
+          (dupd, F22elem, F21blr_, F12blr_, F22blr_,
+           upd_tiles_, opts.BLR_options());
+      if (lchild_) lchild_->release_work_memory();
+      if (rchild_) rchild_->release_work_memory();
+    } else if (opts.BLR_options().low_rank_algorithm() ==
+               BLR::LowRankAlgorithm::RRQR) {
       DenseM_t F11(dsep, dsep), F12(dsep, dupd), F21(dupd, dsep);
       F11.zero(); F12.zero(); F21.zero();
       A.extract_front(F11, F12, F21, sep_begin_, sep_end_, this->upd_, task_depth);
@@ -301,15 +393,6 @@ namespace strumpack {
         if (lchild_) lchild_->extract_CB_sub_matrix(gI, gJ, B, task_depth);
         if (rchild_) rchild_->extract_CB_sub_matrix(gI, gJ, B, task_depth);
       };
-      auto F22elem = [&](const std::vector<std::size_t>& lI,
-                         const std::vector<std::size_t>& lJ, DenseM_t& B) {
-        B.zero();
-        auto gI = lI; auto gJ = lJ;
-        for (auto& i : gI) i = this->upd_[i];
-        for (auto& j : gJ) j = this->upd_[j];
-        if (lchild_) lchild_->extract_CB_sub_matrix(gI, gJ, B, task_depth);
-        if (rchild_) rchild_->extract_CB_sub_matrix(gI, gJ, B, task_depth);
-      };
       BLR::BLR_construct_and_partial_factor<scalar_t>
         (dsep, dupd, F11elem, F12elem, F21elem, F22elem,
          F11blr_, piv_, F12blr_, F21blr_, F22blr_,
@@ -425,10 +508,16 @@ template<typename scalar_t,typename integer_t> void
     std::vector<std::size_t> lI, oI;
     this->find_upd_indices(I, lI, oI);
     if (lI.empty()) return;
-    auto T = F22blr_.extract(lI, lJ);
-    for (std::size_t j=0; j<lJ.size(); j++)
-      for (std::size_t i=0; i<lI.size(); i++)
-        B(oI[i], oJ[j]) += T(i, j);
+    if (F22blr_.rows() != std::size_t(dim_upd())) {
+      for (std::size_t j=0; j<lJ.size(); j++)
+        for (std::size_t i=0; i<lI.size(); i++)
+          B(oI[i], oJ[j]) += F22_(lI[i], lJ[j]);
+    } else {
+      auto T = F22blr_.extract(lI, lJ);
+      for (std::size_t j=0; j<lJ.size(); j++)
+        for (std::size_t i=0; i<lI.size(); i++)
+          B(oI[i], oJ[j]) += T(i, j);
+    }
     STRUMPACK_FLOPS((is_complex<scalar_t>() ? 2 : 1) * lJ.size() * lI.size());
   }
 
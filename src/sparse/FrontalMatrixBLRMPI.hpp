@@ -208,12 +208,7 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixBLRMPI<scalar_t,integer_t>::multifrontal_factorization
   (const SpMat_t& A, const Opts_t& opts, int etree_level, int task_depth) {
-    if (visit(lchild_))
-      lchild_->multifrontal_factorization
-        (A, opts, etree_level+1, task_depth);
-    if (visit(rchild_))
-      rchild_->multifrontal_factorization
-        (A, opts, etree_level+1, task_depth);
+    this->factor_children(A, opts, etree_level, task_depth);
     build_front(A);
     if (lchild_) lchild_->release_work_memory();
     if (rchild_) rchild_->release_work_memory();
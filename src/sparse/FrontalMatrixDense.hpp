@@ -34,11 +34,14 @@
 #include <algorithm>
 #include <cmath>
 #include <random>
+#include <mutex>
+#include <limits>
 
 #include "misc/TaskTimer.hpp"
 #include "dense/BLASLAPACKWrapper.hpp"
 #include "CompressedSparseMatrix.hpp"
 #include "MatrixReordering.hpp"
+#include "CBWorkspace.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "ExtendAdd.hpp"
 #endif
@@ -51,6 +54,7 @@ namespace strumpack {
     using DenseM_t = DenseMatrix<scalar_t>;
     using DenseMW_t = DenseMatrixWrapper<scalar_t>;
     using SpMat_t = CompressedSparseMatrix<scalar_t,integer_t>;
+    using real_t = typename RealType<scalar_t>::value_type;
 #if defined(STRUMPACK_USE_MPI)
     using ExtAdd = ExtendAdd<scalar_t,integer_t>;
 #endif
@@ -60,7 +64,7 @@ namespace strumpack {
     (integer_t sep, integer_t sep_begin, integer_t sep_end,
      std::vector<integer_t>& upd);
 
-    void release_work_memory() override { F22_.clear(); }
+    void release_work_memory() override { F22_.clear(); F22mem_.clear(); }
     void extend_add_to_dense
     (DenseM_t& paF11, DenseM_t& paF12, DenseM_t& paF21, DenseM_t& paF22,
      const F_t* p, int task_depth) override;
@@ -102,17 +106,38 @@ namespace strumpack {
 
     std::string type() const override { return "FrontalMatrixDense"; }
 
+    // read the factors written by write_factors
+    void read_factors(std::istream& is);
+
 #if defined(STRUMPACK_USE_MPI)
     void extend_add_copy_to_buffers
     (std::vector<std::vector<scalar_t>>& sbuf,
      const FrontalMatrixMPI<scalar_t,integer_t>* pa) const override {
       ExtAdd::extend_add_seq_copy_to_buffers(F22_, sbuf, pa, this);
     }
+    bool packed_extend_add() const override { return true; }
+    void extend_add_send_counts
+    (std::size_t* cnt,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa) const override {
+      ExtAdd::extend_add_seq_send_counts(F22_, cnt, pa, this);
+    }
+    void extend_add_pack
+    (scalar_t* sbuf, const std::size_t* pos,
+     const FrontalMatrixMPI<scalar_t,integer_t>* pa) const override {
+      ExtAdd::extend_add_seq_pack(F22_, sbuf, pos, pa, this);
+    }
 #endif
 
   protected:
-    DenseM_t F11_, F12_, F21_, F22_;
+    DenseM_t F11_, F12_, F21_;
+    // the contribution block, either stored in F22mem_, or on the
+    // stack of a CBWorkspace
+    DenseMW_t F22_;
+    DenseM_t F22mem_;
     std::vector<int> piv; // regular int because it is passed to BLAS
+    // Cholesky: F11 = L L^H, stored in the lower part of F11_, F21_
+    // is overwritten with F21 L^-H and F12_ is not stored
+    bool chol_ = false;
 
     FrontalMatrixDense(const FrontalMatrixDense&) = delete;
     FrontalMatrixDense& operator=(FrontalMatrixDense const&) = delete;
@@ -123,6 +148,31 @@ namespace strumpack {
     void factor_phase2
     (const SpMat_t& A, const SPOptions<scalar_t>& opts,
      int etree_level, int task_depth);
+    void factor_phase2_Cholesky(int task_depth);
+    void factor_DAG
+    (const SpMat_t& A, const SPOptions<scalar_t>& opts,
+     int etree_level, int task_depth);
+    void allocate_front
+    (const SpMat_t& A, const SPOptions<scalar_t>& opts, int task_depth,
+     CBWorkspace<scalar_t>* ws=nullptr);
+    void build_front
+    (const SpMat_t& A, const SPOptions<scalar_t>& opts, int task_depth,
+     CBWorkspace<scalar_t>* ws=nullptr);
+    void factor_workspace
+    (const SpMat_t& A, const SPOptions<scalar_t>& opts,
+     CBWorkspace<scalar_t>& ws, bool root, int etree_level, int task_depth);
+    void factor_batched
+    (const SpMat_t& A, const SPOptions<scalar_t>& opts, int etree_level);
+    void factor_small_LU();
+    void factor_tiled_LU(const SpMat_t& A, const SPOptions<scalar_t>& opts);
+    void replace_tiny_pivots
+    (const SpMat_t& A, std::size_t from=0,
+     std::size_t to=std::numeric_limits<std::size_t>::max());
+    long long factor_flops() const;
+
+    long long node_factor_nonzeros() const override;
+
+    bool write_factors(std::ostream& os) const override;
 
     virtual void fwd_solve_phase2
     (DenseM_t& b, DenseM_t& bupd, int etree_level, int task_depth) const;
@@ -141,6 +191,35 @@ namespace strumpack {
    std::vector<integer_t>& upd)
     : F_t(nullptr, nullptr, sep, sep_begin, sep_end, upd) {}
 
+  template<typename scalar_t,typename integer_t> bool
+  FrontalMatrixDense<scalar_t,integer_t>::write_factors
+  (std::ostream& os) const {
+    char chol = chol_;
+    std::uint64_t npiv = piv.size();
+    os.write(&chol, sizeof(chol));
+    os.write((const char*)&npiv, sizeof(npiv));
+    os.write((const char*)piv.data(), sizeof(int)*npiv);
+    F11_.write(os);
+    F12_.write(os);
+    F21_.write(os);
+    return os.good();
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::read_factors(std::istream& is) {
+    char chol = 0;
+    std::uint64_t npiv = 0;
+    is.read(&chol, sizeof(chol));
+    is.read((char*)&npiv, sizeof(npiv));
+    if (!is.good()) return;
+    chol_ = chol;
+    piv.resize(npiv);
+    is.read((char*)piv.data(), sizeof(int)*npiv);
+    F11_.read(is);
+    F12_.read(is);
+    F21_.read(is);
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixDense<scalar_t,integer_t>::extend_add_to_dense
   (DenseM_t& paF11, DenseM_t& paF12, DenseM_t& paF21, DenseM_t& paF22,
@@ -161,8 +240,10 @@ namespace strumpack {
         for (std::size_t r=upd2sep; r<dupd; r++)
           paF21(I[r]-pdsep,pc) += F22_(r,c);
       } else {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF12(I[r],pc-pdsep) += F22_(r, c);
+        // F12 is not stored for Cholesky, only F21
+        if (paF12.cols())
+          for (std::size_t r=0; r<upd2sep; r++)
+            paF12(I[r],pc-pdsep) += F22_(r, c);
         for (std::size_t r=upd2sep; r<dupd; r++)
           paF22(I[r]-pdsep,pc-pdsep) += F22_(r,c);
       }
@@ -176,6 +257,27 @@ namespace strumpack {
   FrontalMatrixDense<scalar_t,integer_t>::multifrontal_factorization
   (const SpMat_t& A, const SPOptions<scalar_t>& opts,
    int etree_level, int task_depth) {
+    if (this->small_dense_subtree(opts.batch_cutoff())) {
+      factor_batched(A, opts, etree_level);
+      return;
+    }
+    if (opts.use_CB_workspace() &&
+        task_depth >= params::task_recursion_cutoff_level) {
+      // sequential subtree, the CB of this front is passed to the
+      // parent, those of the descendants are kept in a workspace
+      CBWorkspace<scalar_t> ws(this->CB_workspace_size(false));
+      factor_workspace(A, opts, ws, true, etree_level, task_depth);
+      return;
+    }
+    if (opts.use_task_DAG() &&
+        task_depth < params::task_recursion_cutoff_level) {
+      if (task_depth == 0) {
+#pragma omp parallel if(!omp_in_parallel()) default(shared)
+#pragma omp single nowait
+        factor_DAG(A, opts, etree_level, task_depth);
+      } else factor_DAG(A, opts, etree_level, task_depth);
+      return;
+    }
     if (task_depth == 0) {
       // use tasking for children and for extend-add parallelism
 #pragma omp parallel if(!omp_in_parallel()) default(shared)
@@ -214,19 +316,130 @@ namespace strumpack {
         rchild_->multifrontal_factorization
           (A, opts, etree_level+1, task_depth);
     }
+    TraceScope t(TaskType::BUILD_FRONT, this->sep_, etree_level);
+    build_front(A, opts, task_depth);
+  }
+
+  /**
+   * Factorization of this subtree without the fork-join of
+   * factor_phase1. The children are factored in tasks, and each child
+   * task extend-adds its contribution block into this front as soon
+   * as the child is done, while the other child can still be
+   * running. The partial factorization of this front uses the task
+   * parallel BLAS/LAPACK routines, in the same parallel region, so
+   * the top of the tree does not fall back to the (threaded) system
+   * BLAS.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::factor_DAG
+  (const SpMat_t& A, const SPOptions<scalar_t>& opts,
+   int etree_level, int task_depth) {
+    std::mutex m;
+    bool allocated = false;
+    auto child = [&](F_t* ch) {
+      ch->multifrontal_factorization(A, opts, etree_level+1, task_depth+1);
+      // the extend-adds into this front are serialized, they do not
+      // spawn tasks while holding the lock
+      std::lock_guard<std::mutex> lock(m);
+      TraceScope t(TaskType::BUILD_FRONT, this->sep_, etree_level);
+      if (!allocated) {
+        allocate_front(A, opts, params::task_recursion_cutoff_level);
+        allocated = true;
+      }
+      ch->extend_add_to_dense
+        (F11_, F12_, F21_, F22_, this, params::task_recursion_cutoff_level);
+    };
+    if (lchild_)
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      child(lchild_.get());
+    if (rchild_)
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+      child(rchild_.get());
+#pragma omp taskwait
+    if (!allocated) {
+      TraceScope t(TaskType::BUILD_FRONT, this->sep_, etree_level);
+      allocate_front(A, opts, task_depth);
+    }
+    factor_phase2(A, opts, etree_level, task_depth);
+  }
+
+  /**
+   * Sequential postorder factorization of this subtree, keeping the
+   * contribution blocks of the dense fronts on the stack ws. The
+   * contribution block of the root of the subtree is not stored in
+   * ws, since it is still needed by the parent after this returns.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::factor_workspace
+  (const SpMat_t& A, const SPOptions<scalar_t>& opts,
+   CBWorkspace<scalar_t>& ws, bool root, int etree_level, int task_depth) {
+    using FD_t = FrontalMatrixDense<scalar_t,integer_t>;
+    const auto mark = ws.top();
+    for (auto ch : {lchild_.get(), rchild_.get()}) {
+      if (!ch) continue;
+      if (ch->type() == "FrontalMatrixDense" &&
+          !ch->small_dense_subtree(opts.batch_cutoff()))
+        static_cast<FD_t*>(ch)->factor_workspace
+          (A, opts, ws, false, etree_level+1, task_depth);
+      else
+        ch->multifrontal_factorization(A, opts, etree_level+1, task_depth);
+    }
+    {
+      TraceScope t(TaskType::BUILD_FRONT, this->sep_, etree_level);
+      build_front(A, opts, task_depth, root ? nullptr : &ws);
+    }
+    factor_phase2(A, opts, etree_level, task_depth);
+    // the children CBs have been consumed, move this CB down
+    if (ws.contains(F22_.data())) {
+      const std::size_t dupd = dim_upd();
+      F22_ = DenseMW_t
+        (dupd, dupd, ws.pop_to(mark, F22_.data(), dupd*dupd), dupd);
+    } else ws.pop_to(mark);
+  }
+
+  /**
+   * Allocate the front and add the elements from the sparse
+   * matrix. If ws is given, the contribution block is allocated on
+   * that stack.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::allocate_front
+  (const SpMat_t& A, const SPOptions<scalar_t>& opts, int task_depth,
+   CBWorkspace<scalar_t>* ws) {
     // TODO can we allocate the memory in one go??
     const auto dsep = dim_sep();
     const auto dupd = dim_upd();
+    chol_ = opts.factorization() == FactorizationType::CHOLESKY;
     F11_ = DenseM_t(dsep, dsep); F11_.zero();
-    F12_ = DenseM_t(dsep, dupd); F12_.zero();
+    if (chol_) F12_.clear();
+    else { F12_ = DenseM_t(dsep, dupd); F12_.zero(); }
     F21_ = DenseM_t(dupd, dsep); F21_.zero();
     A.extract_front
       (F11_, F12_, F21_, this->sep_begin_, this->sep_end_,
        this->upd_, task_depth);
     if (dupd) {
-      F22_ = DenseM_t(dupd, dupd);
+      auto d = ws ? ws->push(dupd*dupd) : nullptr;
+      if (!d) {
+        F22mem_ = DenseM_t(dupd, dupd);
+        d = F22mem_.data();
+      }
+      F22_ = DenseMW_t(dupd, dupd, d, dupd);
       F22_.zero();
     }
+  }
+
+  /**
+   * Allocate the front, add the elements from the sparse matrix and
+   * extend-add the contribution blocks from the children. If ws is
+   * given, the contribution block is allocated on that stack.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::build_front
+  (const SpMat_t& A, const SPOptions<scalar_t>& opts, int task_depth,
+   CBWorkspace<scalar_t>* ws) {
+    allocate_front(A, opts, task_depth, ws);
     if (lchild_)
       lchild_->extend_add_to_dense
         (F11_, F12_, F21_, F22_, this, task_depth);
@@ -239,26 +452,36 @@ namespace strumpack {
   FrontalMatrixDense<scalar_t,integer_t>::factor_phase2
   (const SpMat_t& A, const SPOptions<scalar_t>& opts,
    int etree_level, int task_depth) {
+    TraceScope trace(TaskType::FACTOR_FRONT, this->sep_, etree_level);
+    trace.add_flops(factor_flops());
+    if (chol_) {
+      TaskTimer t("");
+      if (etree_level == 0 && opts.print_root_front_stats()) t.start();
+      factor_phase2_Cholesky(task_depth);
+      if (etree_level == 0 && opts.print_root_front_stats())
+        std::cout << "#   - dense root front (Cholesky): N = " << dim_sep()
+                  << " , N^2 = " << dim_sep() * dim_sep()
+                  << " time = " << t.elapsed() << " sec" << std::endl;
+      return;
+    }
     if (dim_sep()) {
       TaskTimer t("");
       if (etree_level == 0 && opts.print_root_front_stats()) t.start();
-      piv = F11_.LU(task_depth);
-      if (opts.replace_tiny_pivots()) {
-        // TODO consider other values for thresh
-        //  - sqrt(eps)*|A|_1 as in SuperLU ?
-        auto thresh = blas::lamch<real_t>('E') * A.size();
-        for (std::size_t i=0; i<F11_.rows(); i++)
-          if (std::abs(F11_(i,i)) < thresh)
-            F11_(i,i) = (std::real(F11_(i,i)) < 0) ? -thresh : thresh;
-      }
-      if (dim_upd()) {
-        F12_.laswp(piv, true);
-        trsm(Side::L, UpLo::L, Trans::N, Diag::U,
-             scalar_t(1.), F11_, F12_, task_depth);
-        trsm(Side::R, UpLo::U, Trans::N, Diag::N,
-             scalar_t(1.), F11_, F21_, task_depth);
-        gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_,
-             scalar_t(1.), F22_, task_depth);
+      if (opts.tiled_LU_cutoff() &&
+          dim_sep() >= std::size_t(opts.tiled_LU_cutoff()))
+        factor_tiled_LU(A, opts);
+      else {
+        piv = F11_.LU(task_depth);
+        if (opts.replace_tiny_pivots()) replace_tiny_pivots(A);
+        if (dim_upd()) {
+          F12_.laswp(piv, true);
+          trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+               scalar_t(1.), F11_, F12_, task_depth);
+          trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+               scalar_t(1.), F11_, F21_, task_depth);
+          gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_,
+               scalar_t(1.), F22_, task_depth);
+        }
       }
       if (etree_level == 0 && opts.print_root_front_stats()) {
         auto time = t.elapsed();
@@ -267,11 +490,279 @@ namespace strumpack {
                   << " time = " << time << " sec" << std::endl;
       }
     }
-    STRUMPACK_FULL_RANK_FLOPS
-      (LU_flops(F11_) +
-       gemm_flops(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.)) +
-       trsm_flops(Side::L, scalar_t(1.), F11_, F12_) +
-       trsm_flops(Side::R, scalar_t(1.), F11_, F21_));
+    STRUMPACK_FULL_RANK_FLOPS(factor_flops());
+  }
+
+  /**
+   * Partial LU factorization of this front, F11, F12, F21 and F22
+   * together, split in column tiles of width nb. The F21/F22 part is
+   * also split in row tiles. Every panel factorization, and every
+   * update of a tile with a panel, is an OpenMP task, with
+   * dependencies between the tiles. The factorization of panel k+1
+   * can start as soon as it has been updated with panel k, while the
+   * other updates with panel k are still running (lookahead). As in
+   * the getrf/trsm/gemm version, pivoting is restricted to the rows of
+   * F11. The row interchanges in the columns left of a panel are
+   * applied at the end.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::factor_tiled_LU
+  (const SpMat_t& A, const SPOptions<scalar_t>& opts) {
+    const std::size_t nb = 256, dsep = dim_sep(), dupd = dim_upd(),
+      K = (dsep + nb - 1) / nb,      // column tiles in F11
+      N = K + (dupd + nb - 1) / nb,  // column tiles in the front
+      R = (dupd + nb - 1) / nb;      // row tiles in F21/F22
+    const int seq = params::task_recursion_cutoff_level;
+    piv.resize(dsep);
+    auto width = [&](std::size_t j) {
+      return j < K ? std::min(nb, dsep-j*nb) : std::min(nb, dupd-(j-K)*nb);
+    };
+    // column tile j of F11/F12
+    auto top = [&](std::size_t j) {
+      return j < K ? DenseMW_t(dsep, width(j), F11_, 0, j*nb) :
+        DenseMW_t(dsep, width(j), F12_, 0, (j-K)*nb);
+    };
+    // row tile i of column tile j of F21/F22
+    auto bot = [&](std::size_t i, std::size_t j) {
+      auto m = std::min(nb, dupd-i*nb);
+      return j < K ? DenseMW_t(m, width(j), F21_, i*nb, j*nb) :
+        DenseMW_t(m, width(j), F22_, i*nb, (j-K)*nb);
+    };
+    // dependency tokens for the tiles
+    std::vector<char> dtop(N), dbot(R*N);
+    char *dt = dtop.data(), *db = dbot.data();
+    int info = 0;
+    auto factor = [&]() {
+      for (std::size_t k=0; k<K; k++) {
+        const std::size_t k0 = k*nb, kb = width(k);
+#pragma omp task default(shared) firstprivate(k0,kb) depend(inout:dt[k])
+        {
+          DenseMW_t P(dsep-k0, kb, F11_, k0, k0);
+          int kinfo = 0;
+          blas::getrf(P.rows(), kb, P.data(), P.ld(), &piv[k0], &kinfo);
+          if (kinfo) {
+#pragma omp critical
+            if (!info) info = k0 + kinfo;
+          }
+          for (std::size_t i=k0; i<k0+kb; i++) piv[i] += k0;
+          if (opts.replace_tiny_pivots()) replace_tiny_pivots(A, k0, k0+kb);
+        }
+        for (std::size_t i=0; i<R; i++)
+#pragma omp task default(shared) firstprivate(k,k0,kb,i)        \
+  depend(in:dt[k]) depend(inout:db[i*N+k])
+        {
+          auto L = bot(i, k);
+          trsm(Side::R, UpLo::U, Trans::N, Diag::N, scalar_t(1.),
+               DenseMW_t(kb, kb, F11_, k0, k0), L, seq);
+        }
+        for (std::size_t j=k+1; j<N; j++) {
+#pragma omp task default(shared) firstprivate(k0,kb,j)  \
+  depend(in:dt[k]) depend(inout:dt[j])
+          {
+            auto T = top(j);
+            blas::laswp(T.cols(), T.data(), T.ld(), k0+1, k0+kb,
+                        piv.data(), 1);
+            DenseMW_t U(kb, T.cols(), T, k0, 0);
+            trsm(Side::L, UpLo::L, Trans::N, Diag::U, scalar_t(1.),
+                 DenseMW_t(kb, kb, F11_, k0, k0), U, seq);
+            if (k0+kb < dsep) {
+              DenseMW_t T2(dsep-k0-kb, T.cols(), T, k0+kb, 0);
+              gemm(Trans::N, Trans::N, scalar_t(-1.),
+                   DenseMW_t(dsep-k0-kb, kb, F11_, k0+kb, k0), U,
+                   scalar_t(1.), T2, seq);
+            }
+          }
+          for (std::size_t i=0; i<R; i++)
+#pragma omp task default(shared) firstprivate(k,k0,kb,i,j)              \
+  depend(in:dt[j],db[i*N+k]) depend(inout:db[i*N+j])
+          {
+            auto T = top(j);
+            auto B = bot(i, j);
+            gemm(Trans::N, Trans::N, scalar_t(-1.), bot(i, k),
+                 DenseMW_t(kb, T.cols(), T, k0, 0), scalar_t(1.), B, seq);
+          }
+        }
+      }
+#pragma omp taskwait
+    };
+#if defined(_OPENMP)
+    if (omp_in_parallel()) factor();
+    else {
+#pragma omp parallel default(shared)
+#pragma omp single nowait
+      factor();
+    }
+#else
+    factor();
+#endif
+    if (info) {
+      std::cerr << "ERROR: LU factorization failed with info="
+                << info << std::endl;
+      exit(1);
+    }
+    // row interchanges of panel k in the columns left of panel k
+    for (std::size_t k=1; k<K; k++)
+      blas::laswp(k*nb, F11_.data(), F11_.ld(), k*nb+1, k*nb+width(k),
+                  piv.data(), 1);
+  }
+
+  /**
+   * Flops for the partial (LU or Cholesky) factorization of this
+   * front, these only depend on the front dimensions.
+   */
+  template<typename scalar_t,typename integer_t> long long
+  FrontalMatrixDense<scalar_t,integer_t>::factor_flops() const {
+    if (chol_)
+      return Cholesky_flops(F11_) +
+        trsm_flops(Side::R, scalar_t(1.), F11_, F21_) +
+        herk_flops(Trans::N, F21_, F22_);
+    return LU_flops(F11_) +
+      gemm_flops(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.)) +
+      trsm_flops(Side::L, scalar_t(1.), F11_, F12_) +
+      trsm_flops(Side::R, scalar_t(1.), F11_, F21_);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::replace_tiny_pivots
+  (const SpMat_t& A, std::size_t from, std::size_t to) {
+    // TODO consider other values for thresh
+    //  - sqrt(eps)*|A|_1 as in SuperLU ?
+    auto thresh = blas::lamch<real_t>('E') * A.size();
+    for (std::size_t i=from; i<std::min(to, F11_.rows()); i++)
+      if (std::abs(F11_(i,i)) < thresh)
+        F11_(i,i) = (std::real(F11_(i,i)) < 0) ? -thresh : thresh;
+  }
+
+  /**
+   * Factor this subtree, in which all fronts are small and dense,
+   * level by level, starting from the leafs. The fronts of a level
+   * are sorted by size, so that fronts of similar size are handled
+   * together, and are then built and factored in a single parallel
+   * (task)loop, instead of with an OpenMP task per front. The LU
+   * factorization uses the fused kernel factor_small_LU, instead of
+   * separate getrf/trsm/gemm calls.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::factor_batched
+  (const SpMat_t& A, const SPOptions<scalar_t>& opts, int etree_level) {
+    using FD_t = FrontalMatrixDense<scalar_t,integer_t>;
+    const int task_depth = params::task_recursion_cutoff_level;
+    auto factor_front = [&](F_t* front, int level) {
+      auto f = static_cast<FD_t*>(front);
+      {
+        TraceScope t(TaskType::BUILD_FRONT, f->sep_, level);
+        f->build_front(A, opts, task_depth);
+      }
+      TraceScope t(TaskType::FACTOR_FRONT, f->sep_, level);
+      t.add_flops(f->factor_flops());
+      if (f->chol_) f->factor_phase2_Cholesky(task_depth);
+      else if (f->dim_sep()) {
+        f->factor_small_LU();
+        if (opts.replace_tiny_pivots()) f->replace_tiny_pivots(A);
+      }
+    };
+    std::vector<F_t*> fp;
+    for (int l=this->levels()-1; l>=0; l--) {
+      fp.clear();
+      this->get_level_fronts(fp, l);
+      std::sort(fp.begin(), fp.end(), [](const F_t* a, const F_t* b) {
+          return a->dim_blk() < b->dim_blk(); });
+      const std::size_t nf = fp.size();
+      if (omp_in_parallel()) {
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)
+#endif
+        for (std::size_t i=0; i<nf; i++)
+          factor_front(fp[i], etree_level+l);
+      } else {
+#pragma omp parallel for schedule(dynamic)
+        for (std::size_t i=0; i<nf; i++)
+          factor_front(fp[i], etree_level+l);
+      }
+    }
+  }
+
+  /**
+   * Partial LU factorization of the front, with partial pivoting in
+   * F11, as one right-looking unblocked elimination over the four
+   * blocks. This computes the same as getrf on F11, followed by the
+   * row interchanges and the triangular solves for F12 and F21, and
+   * the Schur complement update of F22, but avoids the overhead of
+   * four BLAS/LAPACK calls, which dominates for small fronts. The
+   * inner loops run over contiguous columns.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::factor_small_LU() {
+    const std::size_t dsep = dim_sep(), dupd = dim_upd();
+    piv.resize(dsep);
+    auto cabs1 = [](scalar_t a) {
+      return std::abs(std::real(a)) + std::abs(std::imag(a)); };
+    for (std::size_t k=0; k<dsep; k++) {
+      std::size_t p = k;
+      auto pmax = cabs1(F11_(k,k));
+      for (std::size_t i=k+1; i<dsep; i++) {
+        auto a = cabs1(F11_(i,k));
+        if (a > pmax) { p = i; pmax = a; }
+      }
+      piv[k] = p + 1;
+      if (p != k) {
+        for (std::size_t j=0; j<dsep; j++)
+          std::swap(F11_(k,j), F11_(p,j));
+        for (std::size_t j=0; j<dupd; j++)
+          std::swap(F12_(k,j), F12_(p,j));
+      }
+      if (F11_(k,k) == scalar_t(0.)) continue;
+      const auto ipiv = scalar_t(1.) / F11_(k,k);
+      auto lk = F11_.ptr(0, k), ck = F21_.ptr(0, k);
+      for (std::size_t i=k+1; i<dsep; i++) lk[i] *= ipiv;
+      for (std::size_t i=0; i<dupd; i++) ck[i] *= ipiv;
+      for (std::size_t j=k+1; j<dsep; j++) {
+        const auto u = F11_(k,j);
+        auto lj = F11_.ptr(0, j), cj = F21_.ptr(0, j);
+        for (std::size_t i=k+1; i<dsep; i++) lj[i] -= lk[i] * u;
+        for (std::size_t i=0; i<dupd; i++) cj[i] -= ck[i] * u;
+      }
+      for (std::size_t j=0; j<dupd; j++) {
+        const auto u = F12_(k,j);
+        auto lj = F12_.ptr(0, j), cj = F22_.ptr(0, j);
+        for (std::size_t i=k+1; i<dsep; i++) lj[i] -= lk[i] * u;
+        for (std::size_t i=0; i<dupd; i++) cj[i] -= ck[i] * u;
+      }
+    }
+    STRUMPACK_FLOPS(factor_flops());
+    STRUMPACK_FULL_RANK_FLOPS(factor_flops());
+  }
+
+  /**
+   * F11 = L L^H, F21 := F21 L^-H, F22 := F22 - F21 F21^H. Only the
+   * lower triangular part of F22 is computed by herk, it is then
+   * copied to the upper triangular part, since the extend-add and
+   * the random sampling by (compressed) parents use the full F22.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDense<scalar_t,integer_t>::factor_phase2_Cholesky
+  (int task_depth) {
+    const std::size_t dupd = dim_upd();
+    if (!dim_sep()) return;
+    piv.clear();
+    F11_.Cholesky(task_depth);
+    if (dupd) {
+      trsm(Side::R, UpLo::L, Trans::C, Diag::N,
+           scalar_t(1.), F11_, F21_, task_depth);
+      herk(UpLo::L, Trans::N, real_t(-1.), F21_, real_t(1.), F22_, task_depth);
+      for (std::size_t c=1; c<dupd; c++)
+        for (std::size_t r=0; r<c; r++)
+          F22_(r,c) = blas::my_conj(F22_(c,r));
+    }
+    STRUMPACK_FULL_RANK_FLOPS(factor_flops());
+  }
+
+  template<typename scalar_t,typename integer_t> long long
+  FrontalMatrixDense<scalar_t,integer_t>::node_factor_nonzeros() const {
+    if (!chol_) return F_t::node_factor_nonzeros();
+    long long dsep = dim_sep();
+    long long dupd = dim_upd();
+    return dsep * (dsep + 1) / 2 + dsep * dupd;
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -297,14 +788,15 @@ namespace strumpack {
   (DenseM_t& b, DenseM_t& bupd, int etree_level, int task_depth) const {
     if (dim_sep()) {
       DenseMW_t bloc(dim_sep(), b.cols(), b, this->sep_begin_, 0);
-      bloc.laswp(piv, true);
+      const auto d = chol_ ? Diag::N : Diag::U;
+      if (!chol_) bloc.laswp(piv, true);
       if (b.cols() == 1) {
-        trsv(UpLo::L, Trans::N, Diag::U, F11_, bloc, task_depth);
+        trsv(UpLo::L, Trans::N, d, F11_, bloc, task_depth);
         if (dim_upd())
           gemv(Trans::N, scalar_t(-1.), F21_, bloc,
                scalar_t(1.), bupd, task_depth);
       } else {
-        trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+        trsm(Side::L, UpLo::L, Trans::N, d,
              scalar_t(1.), F11_, bloc, task_depth);
         if (dim_upd())
           gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, bloc,
@@ -336,6 +828,22 @@ namespace strumpack {
   (DenseM_t& y, DenseM_t& yupd, int etree_level, int task_depth) const {
     if (dim_sep()) {
       DenseMW_t yloc(dim_sep(), y.cols(), y, this->sep_begin_, 0);
+      if (chol_) {
+        // y = L^-H (y - F21^H yupd)
+        if (y.cols() == 1) {
+          if (dim_upd())
+            gemv(Trans::C, scalar_t(-1.), F21_, yupd,
+                 scalar_t(1.), yloc, task_depth);
+          trsv(UpLo::L, Trans::C, Diag::N, F11_, yloc, task_depth);
+        } else {
+          if (dim_upd())
+            gemm(Trans::C, Trans::N, scalar_t(-1.), F21_, yupd,
+                 scalar_t(1.), yloc, task_depth);
+          trsm(Side::L, UpLo::L, Trans::C, Diag::N, scalar_t(1.),
+               F11_, yloc, task_depth);
+        }
+        return;
+      }
       if (y.cols() == 1) {
         if (dim_upd())
           gemv(Trans::N, scalar_t(-1.), F12_, yupd,
@@ -419,7 +927,7 @@ namespace strumpack {
       for (std::size_t r=0; r<u2s; r++)
         cR(r,c) = R(Ir[r],c);
     DenseM_t cS(u2s, Rcols);
-    DenseMW_t CB11(u2s, u2s, const_cast<DenseM_t&>(F22_), 0, 0);
+    DenseMW_t CB11(u2s, u2s, const_cast<DenseMW_t&>(F22_), 0, 0);
     gemm(op, Trans::N, scalar_t(1.), CB11, cR, scalar_t(0.), cS, task_depth);
     for (std::size_t c=0; c<Rcols; c++)
       for (std::size_t r=0; r<u2s; r++)
@@ -436,7 +944,7 @@ namespace strumpack {
     auto Ir = this->upd_to_parent(pa, u2s);
     auto pds = pa->dim_sep();
     auto Rcols = R.cols();
-    DenseMW_t CB12(u2s, dupd-u2s, const_cast<DenseM_t&>(F22_), 0, u2s);
+    DenseMW_t CB12(u2s, dupd-u2s, const_cast<DenseMW_t&>(F22_), 0, u2s);
     if (op == Trans::N) {
       DenseM_t cR(dupd-u2s, Rcols);
       for (std::size_t c=0; c<Rcols; c++)
@@ -471,7 +979,7 @@ namespace strumpack {
     auto Ir = this->upd_to_parent(pa, u2s);
     auto Rcols = R.cols();
     auto pds = pa->dim_sep();
-    DenseMW_t CB21(dupd-u2s, u2s, const_cast<DenseM_t&>(F22_), u2s, 0);
+    DenseMW_t CB21(dupd-u2s, u2s, const_cast<DenseMW_t&>(F22_), u2s, 0);
     if (op == Trans::N) {
       DenseM_t cR(u2s, Rcols);
       for (std::size_t c=0; c<Rcols; c++)
@@ -511,7 +1019,7 @@ namespace strumpack {
       for (std::size_t r=u2s; r<dupd; r++)
         cR(r-u2s,c) = R(Ir[r]-pds,c);
     DenseM_t cS(dupd-u2s, Rcols);
-    DenseMW_t CB22(dupd-u2s, dupd-u2s, const_cast<DenseM_t&>(F22_), u2s, u2s);
+    DenseMW_t CB22(dupd-u2s, dupd-u2s, const_cast<DenseMW_t&>(F22_), u2s, u2s);
     gemm(op, Trans::N, scalar_t(1.), CB22, cR, scalar_t(0.), cS, task_depth);
     for (std::size_t c=0; c<Rcols; c++)
       for (std::size_t r=u2s; r<dupd; r++)
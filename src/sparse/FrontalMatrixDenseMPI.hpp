@@ -33,6 +33,7 @@
 #include <fstream>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include "misc/TaskTimer.hpp"
 #include "misc/MPIWrapper.hpp"
 #include "dense/DistributedMatrix.hpp"
@@ -74,12 +75,22 @@ namespace strumpack {
     void release_work_memory() override;
     void build_front(const SpMat_t& A);
     void partial_factorization();
+    void partial_factorization_Cholesky();
 
     void extend_add();
     void extend_add_copy_to_buffers
     (std::vector<std::vector<scalar_t>>& sbuf, const FMPI_t* pa) const override {
       ExtAdd::extend_add_copy_to_buffers(F22_, sbuf, pa, this->upd_to_parent(pa));
     }
+    bool packed_extend_add() const override { return true; }
+    void extend_add_send_counts
+    (std::size_t* cnt, const FMPI_t* pa) const override {
+      ExtAdd::extend_add_send_counts(F22_, cnt, pa, this->upd_to_parent(pa));
+    }
+    void extend_add_pack
+    (scalar_t* sbuf, const std::size_t* pos, const FMPI_t* pa) const override {
+      ExtAdd::extend_add_pack(F22_, sbuf, pos, pa, this->upd_to_parent(pa));
+    }
 
     void sample_CB
     (const DistM_t& R, DistM_t& Sr, DistM_t& Sc, F_t* pa) const override;
@@ -104,9 +115,23 @@ namespace strumpack {
 
     std::string type() const override { return "FrontalMatrixDenseMPI"; }
 
+  protected:
+    long long node_factor_nonzeros() const override;
+
   private:
     DistM_t F11_, F12_, F21_, F22_;
     std::vector<int> piv;
+    // Cholesky: F11 = L L^H in the lower part of F11_, F21_ is
+    // overwritten with F21 L^-H, F12_ is released after factorization
+    bool chol_ = false;
+    // communication plan for the packed extend-add: number of
+    // elements sent to each process of Comm(), for the left and the
+    // right child, and received from each process. Computed from the
+    // symbolic data on the first factorization, and reused for
+    // refactorization.
+    std::vector<std::size_t> ea_scnt_, ea_rcnt_;
+    bool ea_packed_ = false;
+    bool extend_add_packed();
 #if defined(STRUMPACK_USE_SLATE_SCALAPACK)
     slate::Matrix<scalar_t> slateF11_, slateF12_, slateF21_, slateF22_;
     slate::Pivots slate_piv_;
@@ -145,12 +170,14 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixDenseMPI<scalar_t,integer_t>::extend_add() {
     if (!lchild_ && !rchild_) return;
-    std::vector<std::vector<scalar_t>> sbuf(this->P());
-    for (auto& ch : {lchild_.get(), rchild_.get()}) {
+    for (auto& ch : {lchild_.get(), rchild_.get()})
       if (ch && Comm().is_root()) {
         STRUMPACK_FLOPS
           (static_cast<long long int>(ch->dim_upd())*ch->dim_upd());
       }
+    if (extend_add_packed()) return;
+    std::vector<std::vector<scalar_t>> sbuf(this->P());
+    for (auto& ch : {lchild_.get(), rchild_.get()}) {
       if (!visit(ch)) continue;
       ch->extend_add_copy_to_buffers(sbuf, this);
     }
@@ -164,6 +191,80 @@ namespace strumpack {
     }
   }
 
+  /**
+   * Extend-add with the counts from the communication plan. Both the
+   * sender and the receiver compute the counts from the symbolic
+   * data, so no counts need to be exchanged. The children pack
+   * directly into a single contiguous send buffer, and only
+   * processes that actually exchange data communicate, using
+   * nonblocking point-to-point messages instead of an all-to-all on
+   * the communicator of this front. Returns false, and does nothing,
+   * when one of the children does not support this, or when a count
+   * overflows an int on any of the processes, in which case the
+   * regular extend-add is used.
+   */
+  template<typename scalar_t,typename integer_t> bool
+  FrontalMatrixDenseMPI<scalar_t,integer_t>::extend_add_packed() {
+    for (auto& ch : {lchild_.get(), rchild_.get()})
+      if (ch && !ch->packed_extend_add()) return false;
+    const int P = this->P();
+    if (ea_rcnt_.empty()) {
+      ea_scnt_.assign(2*P, 0);
+      ea_rcnt_.assign(P, 0);
+      int i = 0;
+      for (auto& ch : {lchild_.get(), rchild_.get()}) {
+        if (visit(ch)) ch->extend_add_send_counts(ea_scnt_.data()+i*P, this);
+        if (ch) ch->extend_add_recv_counts(F11_, F22_, ea_rcnt_.data(), this);
+        i++;
+      }
+      const std::size_t imax = std::numeric_limits<int>::max();
+      int fits = 1;
+      for (int p=0; p<P; p++)
+        if (ea_scnt_[p] + ea_scnt_[P+p] > imax || ea_rcnt_[p] > imax)
+          fits = 0;
+      ea_packed_ = Comm().all_reduce(fits, MPI_MIN);
+    }
+    if (!ea_packed_) return false;
+    std::vector<std::size_t> sdispl(P+1), rdispl(P+1);
+    for (int p=0; p<P; p++) {
+      sdispl[p+1] = sdispl[p] + ea_scnt_[p] + ea_scnt_[P+p];
+      rdispl[p+1] = rdispl[p] + ea_rcnt_[p];
+    }
+    std::vector<scalar_t,NoInit<scalar_t>> sbuf(sdispl[P]), rbuf(rdispl[P]);
+    {
+      std::vector<std::size_t> pos(sdispl.begin(), sdispl.end()-1);
+      int i = 0;
+      for (auto& ch : {lchild_.get(), rchild_.get()}) {
+        if (visit(ch)) ch->extend_add_pack(sbuf.data(), pos.data(), this);
+        for (int p=0; p<P; p++) pos[p] += ea_scnt_[i*P+p];
+        i++;
+      }
+    }
+    std::vector<MPI_Request> reqs;
+    reqs.reserve(2*P);
+    for (int p=0; p<P; p++)
+      if (ea_rcnt_[p]) {
+        reqs.emplace_back();
+        MPI_Irecv(rbuf.data()+rdispl[p], ea_rcnt_[p], mpi_type<scalar_t>(),
+                  p, 0, Comm().comm(), &reqs.back());
+      }
+    for (int p=0; p<P; p++)
+      if (sdispl[p+1] > sdispl[p]) {
+        reqs.emplace_back();
+        MPI_Isend(sbuf.data()+sdispl[p], sdispl[p+1]-sdispl[p],
+                  mpi_type<scalar_t>(), p, 0, Comm().comm(), &reqs.back());
+      }
+    MPI_Waitall(reqs.size(), reqs.data(), MPI_STATUSES_IGNORE);
+    std::vector<scalar_t*> pbuf(P);
+    for (int p=0; p<P; p++) pbuf[p] = rbuf.data() + rdispl[p];
+    for (auto& ch : {lchild_.get(), rchild_.get()}) {
+      if (!ch) continue;
+      ch->extend_add_copy_from_buffers
+        (F11_, F12_, F21_, F22_, pbuf.data()+this->master(ch), this);
+    }
+    return true;
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixDenseMPI<scalar_t,integer_t>::build_front
   (const SpMat_t& A) {
@@ -212,6 +313,10 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixDenseMPI<scalar_t,integer_t>::partial_factorization() {
+    if (chol_) {
+      partial_factorization_Cholesky();
+      return;
+    }
     if (this->dim_sep() && grid()->active()) {
 #if defined(STRUMPACK_USE_SLATE_SCALAPACK)
       slate::getrf(slateF11_, slate_piv_, slate_opts_);
@@ -239,16 +344,44 @@ namespace strumpack {
     }
   }
 
+  /**
+   * F11 = L L^H, F21 := F21 L^-H and F22 := F22 - F21 F21^H. F12 is
+   * only needed for the extend-add from the children, and is
+   * released here. The Schur update is done with a full gemm, since
+   * the extend-add to the parent requires all of F22.
+   */
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixDenseMPI<scalar_t,integer_t>::partial_factorization_Cholesky() {
+    F12_.clear();
+    if (this->dim_sep() && grid()->active()) {
+      F11_.Cholesky();
+      STRUMPACK_FULL_RANK_FLOPS(Cholesky_flops(F11_));
+      if (this->dim_upd()) {
+        trsm(Side::R, UpLo::L, Trans::C, Diag::N, scalar_t(1.), F11_, F21_);
+        gemm(Trans::N, Trans::C, scalar_t(-1.), F21_, F21_, scalar_t(1.), F22_);
+        STRUMPACK_FULL_RANK_FLOPS
+          (gemm_flops(Trans::N, Trans::C, scalar_t(-1.), F21_, F21_, scalar_t(1.)) +
+           trsm_flops(Side::R, scalar_t(1.), F11_, F21_));
+      }
+    }
+  }
+
+  template<typename scalar_t,typename integer_t> long long
+  FrontalMatrixDenseMPI<scalar_t,integer_t>::node_factor_nonzeros() const {
+    if (!chol_) return FMPI_t::node_factor_nonzeros();
+    long long dsep = this->dim_sep();
+    long long dupd = this->dim_upd();
+    return Comm().is_root() ? dsep * (dsep + 1) / 2 + dsep * dupd : 0;
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixDenseMPI<scalar_t,integer_t>::multifrontal_factorization
   (const SpMat_t& A, const SPOptions<scalar_t>& opts,
    int etree_level, int task_depth) {
-    if (visit(lchild_))
-      lchild_->multifrontal_factorization(A, opts, etree_level+1, task_depth);
-    if (visit(rchild_))
-      rchild_->multifrontal_factorization(A, opts, etree_level+1, task_depth);
+    this->factor_children(A, opts, etree_level, task_depth);
     TaskTimer t("");
     if (etree_level == 0 && opts.print_root_front_stats()) t.start();
+    chol_ = opts.factorization() == FactorizationType::CHOLESKY;
     build_front(A);
     if (etree_level == 0 && opts.write_root_front()) {
       F11_.print_to_files("Froot");
@@ -281,7 +414,18 @@ namespace strumpack {
     bupd = DistM_t(grid(), this->dim_upd(), b.cols());
     bupd.zero();
     this->extend_add_b(b, bupd, CBl, CBr, seqCBl, seqCBr);
-    if (this->dim_sep()) {
+    if (this->dim_sep() && chol_) {
+      TIMER_TIME(TaskType::SOLVE_LOWER, 0, t_s);
+      if (b.cols() == 1) {
+        trsv(UpLo::L, Trans::N, Diag::N, F11_, b);
+        if (this->dim_upd())
+          gemv(Trans::N, scalar_t(-1.), F21_, b, scalar_t(1.), bupd);
+      } else {
+        trsm(Side::L, UpLo::L, Trans::N, Diag::N, scalar_t(1.), F11_, b);
+        if (this->dim_upd())
+          gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, b, scalar_t(1.), bupd);
+      }
+    } else if (this->dim_sep()) {
       TIMER_TIME(TaskType::SOLVE_LOWER, 0, t_s);
 #if defined(STRUMPACK_USE_SLATE_SCALAPACK)
       auto sbloc = slate::Matrix<scalar_t>::fromScaLAPACK
@@ -318,7 +462,18 @@ namespace strumpack {
   (DenseM_t& yloc, DistM_t* ydist, DistM_t& yupd, DenseM_t& seqyupd,
    int etree_level) const {
     DistM_t& y = ydist[this->sep_];
-    if (this->dim_sep()) {
+    if (this->dim_sep() && chol_) {
+      TIMER_TIME(TaskType::SOLVE_UPPER, 0, t_s);
+      if (y.cols() == 1) {
+        if (this->dim_upd())
+          gemv(Trans::C, scalar_t(-1.), F21_, yupd, scalar_t(1.), y);
+        trsv(UpLo::L, Trans::C, Diag::N, F11_, y);
+      } else {
+        if (this->dim_upd())
+          gemm(Trans::C, Trans::N, scalar_t(-1.), F21_, yupd, scalar_t(1.), y);
+        trsm(Side::L, UpLo::L, Trans::C, Diag::N, scalar_t(1.), F11_, y);
+      }
+    } else if (this->dim_sep()) {
       TIMER_TIME(TaskType::SOLVE_UPPER, 0, t_s);
 #if defined(STRUMPACK_USE_SLATE_SCALAPACK)
       if (this->dim_upd()) {
@@ -203,10 +203,7 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixHODLRMPI<scalar_t,integer_t>::multifrontal_factorization
   (const SpMat_t& A, const Opts_t& opts, int etree_level, int task_depth) {
-    if (visit(lchild_))
-      lchild_->multifrontal_factorization(A, opts, etree_level+1, task_depth);
-    if (visit(rchild_))
-      rchild_->multifrontal_factorization(A, opts, etree_level+1, task_depth);
+    this->factor_children(A, opts, etree_level, task_depth);
     if (!dim_blk()) return;
     TaskTimer t("");
     if (/*etree_level == 0 && */opts.print_root_front_stats()) t.start();
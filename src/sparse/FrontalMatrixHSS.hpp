@@ -123,6 +123,10 @@ namespace strumpack {
                            construct HSS matrix of this front */
     std::uint32_t _sampled_columns = 0;
 
+    /** HSS partition tree, computed in partition, used to (re)create
+        _H for every (re)factorization */
+    HSS::HSSPartitionTree _Htree;
+
   private:
     FrontalMatrixHSS(const FrontalMatrixHSS&) = delete;
     FrontalMatrixHSS& operator=(FrontalMatrixHSS const&) = delete;
@@ -198,8 +202,9 @@ namespace strumpack {
         for (std::size_t r=upd2sep; r<dupd; r++)
           paF21(I[r]-pdsep,pc) += F22(r,c);
       } else {
-        for (std::size_t r=0; r<upd2sep; r++)
-          paF12(I[r],pc-pdsep) += F22(r,c);
+        if (paF12.cols())
+          for (std::size_t r=0; r<upd2sep; r++)
+            paF12(I[r],pc-pdsep) += F22(r,c);
         for (std::size_t r=upd2sep; r<dupd; r++)
           paF22(I[r]-pdsep,pc-pdsep) += F22(r,c);
       }
@@ -474,6 +479,12 @@ namespace strumpack {
     }
     TaskTimer t("");
     if (/*etree_level == 0 && */opts.print_root_front_stats()) t.start();
+    if (!_H.is_untouched()) {
+      // refactorization with new values: start from a fresh HSS
+      // matrix, the old one has been compressed and truncated
+      _H = HSS::HSSMatrix<scalar_t>(_Htree, opts.HSS_options());
+      _sampled_columns = 0;
+    }
     _H.set_openmp_task_depth(task_depth);
     auto mult = [&](DenseM_t& Rr, DenseM_t& Rc, DenseM_t& Sr, DenseM_t& Sc) {
       TIMER_TIME(TaskType::RANDOM_SAMPLING, 0, t_sampling);
@@ -660,15 +671,15 @@ namespace strumpack {
     for (integer_t i=sep_begin_; i<sep_end_; i++)
       sorder[i] += sep_begin_;
     if (is_root)
-      _H = HSS::HSSMatrix<scalar_t>(sep_tree, opts.HSS_options());
+      _Htree = sep_tree;
     else {
-      HSS::HSSPartitionTree tree(this->dim_blk());
-      tree.c.reserve(2);
-      tree.c.push_back(sep_tree);
-      tree.c.emplace_back(dim_upd());
-      tree.c.back().refine(opts.HSS_options().leaf_size());
-      _H = HSS::HSSMatrix<scalar_t>(tree, opts.HSS_options());
+      _Htree = HSS::HSSPartitionTree(this->dim_blk());
+      _Htree.c.reserve(2);
+      _Htree.c.push_back(sep_tree);
+      _Htree.c.emplace_back(dim_upd());
+      _Htree.c.back().refine(opts.HSS_options().leaf_size());
     }
+    _H = HSS::HSSMatrix<scalar_t>(_Htree, opts.HSS_options());
   }
 
 } // end namespace strumpack
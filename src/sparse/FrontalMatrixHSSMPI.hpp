@@ -101,6 +101,7 @@ namespace strumpack {
      bool is_root=true, int task_depth=0) override;
 
   private:
+    HSS::HSSPartitionTree hss_tree_;
     std::unique_ptr<HSS::HSSMatrixMPI<scalar_t>> H_;
     HSS::HSSFactorsMPI<scalar_t> ULV_;
 
@@ -221,16 +222,17 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   FrontalMatrixHSSMPI<scalar_t,integer_t>::multifrontal_factorization
   (const SpMat_t& A, const Opts_t& opts, int etree_level, int task_depth) {
-    if (visit(lchild_))
-      lchild_->multifrontal_factorization
-        (A, opts, etree_level+1, task_depth);
-    if (visit(rchild_))
-      rchild_->multifrontal_factorization
-        (A, opts, etree_level+1, task_depth);
+    this->factor_children(A, opts, etree_level, task_depth);
     if (!dim_blk()) return;
 
     TaskTimer t("");
     if (/*etree_level == 0 && */opts.print_root_front_stats()) t.start();
+    if (H_ && !H_->is_untouched())
+      // refactorization with new values: start from a fresh HSS
+      // matrix, the old one has been compressed and truncated
+      H_ = std::unique_ptr<HSS::HSSMatrixMPI<scalar_t>>
+        (new HSS::HSSMatrixMPI<scalar_t>
+         (hss_tree_, grid(), opts.HSS_options()));
     auto mult = [&](DistM_t& R, DistM_t& Sr, DistM_t& Sc) {
       TIMER_TIME(TaskType::RANDOM_SAMPLING, 0, t_sampling);
       random_sampling(A, opts, R, Sr, Sc);
@@ -488,19 +490,17 @@ namespace strumpack {
     for (integer_t i=sep_begin_; i<sep_end_; i++)
       sorder[i] = sorder[i] + sep_begin_;
     if (is_root)
-      H_ = std::unique_ptr<HSS::HSSMatrixMPI<scalar_t>>
-        (new HSS::HSSMatrixMPI<scalar_t>
-         (sep_tree, grid(), opts.HSS_options()));
+      hss_tree_ = sep_tree;
     else {
-      HSS::HSSPartitionTree hss_tree(dim_blk());
-      hss_tree.c.reserve(2);
-      hss_tree.c.push_back(sep_tree);
-      hss_tree.c.emplace_back(dim_upd());
-      hss_tree.c.back().refine(opts.HSS_options().leaf_size());
-      H_ = std::unique_ptr<HSS::HSSMatrixMPI<scalar_t>>
-        (new HSS::HSSMatrixMPI<scalar_t>
-         (hss_tree, grid(), opts.HSS_options()));
+      hss_tree_ = HSS::HSSPartitionTree(dim_blk());
+      hss_tree_.c.reserve(2);
+      hss_tree_.c.push_back(sep_tree);
+      hss_tree_.c.emplace_back(dim_upd());
+      hss_tree_.c.back().refine(opts.HSS_options().leaf_size());
     }
+    H_ = std::unique_ptr<HSS::HSSMatrixMPI<scalar_t>>
+      (new HSS::HSSMatrixMPI<scalar_t>
+       (hss_tree_, grid(), opts.HSS_options()));
   }
 
 } // end namespace strumpack
@@ -209,14 +209,15 @@ namespace strumpack {
     //FD_t::fwd_solve_phase2(b, bupd, etree_level, task_depth);
     if (this->dim_sep()) {
       DenseMW_t bloc(this->dim_sep(), b.cols(), b, this->sep_begin_, 0);
-      bloc.laswp(this->piv, true);
+      const auto d = this->chol_ ? Diag::N : Diag::U;
+      if (!this->chol_) bloc.laswp(this->piv, true);
       if (b.cols() == 1) {
-        trsv(UpLo::L, Trans::N, Diag::U, F11, bloc, task_depth);
+        trsv(UpLo::L, Trans::N, d, F11, bloc, task_depth);
         if (this->dim_upd())
           gemv(Trans::N, scalar_t(-1.), F21, bloc,
                scalar_t(1.), bupd, task_depth);
       } else {
-        trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+        trsm(Side::L, UpLo::L, Trans::N, d,
              scalar_t(1.), F11, bloc, task_depth);
         if (this->dim_upd())
           gemm(Trans::N, Trans::N, scalar_t(-1.), F21, bloc,
@@ -233,6 +234,21 @@ namespace strumpack {
     // FD_t::bwd_solve_phase1(y, yupd, etree_level, task_depth);
     if (this->dim_sep()) {
       DenseMW_t yloc(this->dim_sep(), y.cols(), y, this->sep_begin_, 0);
+      if (this->chol_) {
+        if (y.cols() == 1) {
+          if (this->dim_upd())
+            gemv(Trans::C, scalar_t(-1.), F21, yupd,
+                 scalar_t(1.), yloc, task_depth);
+          trsv(UpLo::L, Trans::C, Diag::N, F11, yloc, task_depth);
+        } else {
+          if (this->dim_upd())
+            gemm(Trans::C, Trans::N, scalar_t(-1.), F21, yupd,
+                 scalar_t(1.), yloc, task_depth);
+          trsm(Side::L, UpLo::L, Trans::C, Diag::N, scalar_t(1.),
+               F11, yloc, task_depth);
+        }
+        return;
+      }
       if (y.cols() == 1) {
         if (this->dim_upd())
           gemv(Trans::N, scalar_t(-1.), F12, yupd,
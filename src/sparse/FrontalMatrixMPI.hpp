@@ -110,6 +110,13 @@ namespace strumpack {
         (F11, F12, F21, F22, pbuf, pa, this);
     }
 
+    void extend_add_recv_counts
+    (const DistM_t& F11, const DistM_t& F22,
+     std::size_t* cnt, const FMPI_t* pa) const override {
+      ExtAdd::extend_add_recv_counts
+        (F11, F22, cnt+pa->master(this), pa, this);
+    }
+
     void extend_add_column_copy_to_buffers
     (const DistM_t& CB, const DenseM_t& seqCB,
      std::vector<std::vector<scalar_t>>& sbuf, const FMPI_t* pa) const override {
@@ -163,6 +170,8 @@ namespace strumpack {
 
     virtual long long factor_nonzeros(int task_depth=0) const override;
     virtual long long dense_factor_nonzeros(int task_depth=0) const override;
+    long long dense_peak_memory
+    (const Opts_t& opts, long long& after, int task_depth=0) const override;
     virtual std::string type() const override { return "FrontalMatrixMPI"; }
     virtual bool isMPI() const override { return true; }
 
@@ -170,13 +179,27 @@ namespace strumpack {
     (const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
      bool is_root=true, int task_depth=0) override;
 
+    /**
+     * Time spent by this process in the factorization of a
+     * sequential child, ie, the root of the local subtree of this
+     * process, during the last call to factor_children.
+     */
+    double local_subtree_time() const { return local_subtree_time_; }
+
   protected:
     BLACSGrid blacs_grid_;     // 2D processor grid
+    double local_subtree_time_ = 0.;
+
+    /**
+     * Factor the children which this process needs to visit, and
+     * record the time for the sequential ones.
+     */
+    void factor_children
+    (const SpMat_t& A, const Opts_t& opts, int etree_level, int task_depth);
 
     using FrontalMatrix<scalar_t,integer_t>::lchild_;
     using FrontalMatrix<scalar_t,integer_t>::rchild_;
 
-  private:
     long long node_factor_nonzeros() const override;
   };
 
@@ -273,6 +296,19 @@ namespace strumpack {
       extract_CB_sub_matrix_2d(I[i], J[i], B[i]);
   }
 
+  template<typename scalar_t,typename integer_t> void
+  FrontalMatrixMPI<scalar_t,integer_t>::factor_children
+  (const SpMat_t& A, const Opts_t& opts, int etree_level, int task_depth) {
+    local_subtree_time_ = 0.;
+    for (auto ch : {lchild_.get(), rchild_.get()}) {
+      if (!visit(ch)) continue;
+      TaskTimer t("");
+      if (!ch->isMPI()) t.start();
+      ch->multifrontal_factorization(A, opts, etree_level+1, task_depth);
+      if (!ch->isMPI()) local_subtree_time_ += t.elapsed();
+    }
+  }
+
   /**
    * Check if the child needs to be visited. Not necessary when this
    * rank is not part of the processes assigned to the child.
@@ -370,6 +406,31 @@ namespace strumpack {
     return nnz;
   }
 
+  /**
+   * Memory on this rank, the distributed fronts are assumed to be
+   * evenly distributed over the ranks in their grid.
+   */
+  template<typename scalar_t,typename integer_t> long long
+  FrontalMatrixMPI<scalar_t,integer_t>::dense_peak_memory
+  (const Opts_t& opts, long long& after, int task_depth) const {
+    long long al = 0, ar = 0, pl = 0, pr = 0, cbl = 0, cbr = 0;
+    if (visit(lchild_)) {
+      long long dupd = lchild_->dim_upd();
+      pl = lchild_->dense_peak_memory(opts, al, task_depth);
+      cbl = dupd * dupd / lchild_->P();
+    }
+    if (visit(rchild_)) {
+      long long dupd = rchild_->dim_upd();
+      pr = rchild_->dense_peak_memory(opts, ar, task_depth);
+      cbr = dupd * dupd / rchild_->P();
+    }
+    long long dsep = this->dim_sep(), dupd = this->dim_upd();
+    long long front = al + ar +
+      (dsep * (dsep + 2 * dupd) + dupd * dupd) / P();
+    after = front - cbl - cbr;
+    return std::max(std::max(pl, al + pr), front);
+  }
+
   template<typename scalar_t,typename integer_t> long long
   FrontalMatrixMPI<scalar_t,integer_t>::factor_nonzeros
   (int task_depth) const {
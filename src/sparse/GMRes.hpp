@@ -147,6 +147,159 @@ namespace strumpack {
     return rho;
   }
 
+  /*
+   * This is left preconditioned restarted block GMRes, for multiple
+   * right hand sides.
+   *
+   * All k columns of x and b are iterated on together: each
+   * iteration applies spmm and the preconditioner once to an n x k
+   * block, and the block Arnoldi process uses gemm-based
+   * (BLAS-3) Gram-Schmidt. The block Hessenberg matrix, with k
+   * subdiagonals, is reduced to upper triangular form with Givens
+   * rotations. The iteration stops when the preconditioned residual
+   * of every column satisfies the relative or absolute tolerance.
+   */
+  template<typename scalar_t,
+           typename real_t = typename RealType<scalar_t>::value_type>
+  real_t BlockGMRes
+  (const std::function<void(const DenseMatrix<scalar_t>&,
+                            DenseMatrix<scalar_t>&)>& spmm,
+   const std::function<void(DenseMatrix<scalar_t>&)>& preconditioner,
+   DenseMatrix<scalar_t>& x, const DenseMatrix<scalar_t>& b,
+   real_t rtol, real_t atol, int& totit, int maxit, int restart,
+   GramSchmidtType GStype, bool non_zero_guess, bool verbose) {
+    using DenseM_t = DenseMatrix<scalar_t>;
+    using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+    if (restart > maxit) restart = maxit;
+    const std::size_t n = x.rows(), k = x.cols();
+    assert(n >= k);
+    DenseM_t V(n, (restart+1)*k), H((restart+1)*k, restart*k),
+      G((restart+1)*k, k), b_prec(b);
+    // for column c of H, rotation i (1..k) acts on rows c and c+i
+    std::vector<scalar_t> givens_c(restart*k*(k+1)),
+      givens_s(restart*k*(k+1));
+    std::vector<real_t> rho0(k), rho(k);
+    std::vector<scalar_t> tau(k);
+    real_t res = real_t(0.), rel_res = real_t(0.);
+
+    // W = Q R, Q overwrites W, the upper triangle is stored in R
+    auto qr = [&](DenseM_t& W, DenseM_t& R) {
+      blas::geqrf(n, k, W.data(), W.ld(), tau.data());
+      for (std::size_t j=0; j<k; j++)
+        for (std::size_t i=0; i<k; i++)
+          R(i, j) = (i <= j) ? W(i, j) : scalar_t(0.);
+      blas::xxgqr(n, k, k, W.data(), W.ld(), tau.data());
+    };
+    auto rotate = [](scalar_t c, scalar_t s, scalar_t& a, scalar_t& b) {
+      auto t = blas::my_conj(c)*a + blas::my_conj(s)*b;
+      b = -s*a + c*b;
+      a = t;
+    };
+    // max absolute and relative residual, over all columns
+    auto residuals = [&]() {
+      res = rel_res = real_t(0.);
+      for (std::size_t j=0; j<k; j++) {
+        res = std::max(res, rho[j]);
+        if (rho0[j] != real_t(0.))
+          rel_res = std::max(rel_res, rho[j]/rho0[j]);
+      }
+      return res < atol || rel_res < rtol;
+    };
+
+    preconditioner(b_prec);
+    bool no_conv = true;
+    totit = 0;
+    while (no_conv) {
+      DenseMW_t V0(n, k, V, 0, 0);
+      if (non_zero_guess || totit>0) {
+        spmm(x, V0);
+        preconditioner(V0);
+        V0.scale_and_add(scalar_t(-1.), b_prec);
+      } else {
+        V0.copy(b_prec);
+        x.zero();
+      }
+      for (std::size_t j=0; j<k; j++) {
+        rho[j] = blas::nrm2(n, V0.ptr(0, j), 1);
+        if (totit==0) rho0[j] = rho[j];
+      }
+      if (residuals()) break;
+      G.zero();
+      DenseMW_t G0(k, k, G, 0, 0);
+      qr(V0, G0);
+
+      int nrit = restart-1;
+      if (verbose)
+        std::cout << "BlockGMRES it. " << totit << "\tres = "
+                  << std::setw(12) << res
+                  << "\trel.res = " << std::setw(12)
+                  << rel_res << "\t restart!" << std::endl;
+      for (int it=0; it<restart; it++) {
+        totit++;
+        DenseMW_t Vit(n, k, V, 0, it*k), W(n, k, V, 0, (it+1)*k);
+        spmm(Vit, W);
+        preconditioner(W);
+
+        if (GStype == GramSchmidtType::CLASSICAL) {
+          DenseMW_t Vb(n, (it+1)*k, V, 0, 0),
+            Hb((it+1)*k, k, H, 0, it*k);
+          gemm(Trans::C, Trans::N, scalar_t(1.), Vb, W, scalar_t(0.), Hb);
+          gemm(Trans::N, Trans::N, scalar_t(-1.), Vb, Hb, scalar_t(1.), W);
+        } else if (GStype == GramSchmidtType::MODIFIED) {
+          for (int l=0; l<=it; l++) {
+            DenseMW_t Vl(n, k, V, 0, l*k), Hl(k, k, H, l*k, it*k);
+            gemm(Trans::C, Trans::N, scalar_t(1.), Vl, W, scalar_t(0.), Hl);
+            gemm(Trans::N, Trans::N, scalar_t(-1.), Vl, Hl, scalar_t(1.), W);
+          }
+        }
+        for (std::size_t i=(it+1)*k; i<(restart+1)*k; i++)
+          for (std::size_t j=it*k; j<(it+1)*k; j++)
+            H(i, j) = scalar_t(0.);
+        DenseMW_t Hsub(k, k, H, (it+1)*k, it*k);
+        qr(W, Hsub);
+
+        for (std::size_t c=it*k; c<(it+1)*k; c++) {
+          // apply the rotations from the previous columns
+          for (std::size_t cp=0; cp<c; cp++)
+            for (std::size_t i=1; i<=k; i++)
+              rotate(givens_c[cp*(k+1)+i], givens_s[cp*(k+1)+i],
+                     H(cp, c), H(cp+i, c));
+          // eliminate the k subdiagonal elements of column c
+          for (std::size_t i=1; i<=k; i++) {
+            auto h1 = H(c, c), h2 = H(c+i, c);
+            auto delta = std::sqrt(std::norm(h1) + std::norm(h2));
+            auto& gc = givens_c[c*(k+1)+i];
+            auto& gs = givens_s[c*(k+1)+i];
+            if (delta == real_t(0.)) { gc = scalar_t(1.); gs = scalar_t(0.); }
+            else { gc = h1 / delta; gs = h2 / delta; }
+            H(c, c) = delta;
+            H(c+i, c) = scalar_t(0.);
+            for (std::size_t j=0; j<k; j++)
+              rotate(gc, gs, G(c, j), G(c+i, j));
+          }
+        }
+        for (std::size_t j=0; j<k; j++)
+          rho[j] = blas::nrm2(k, G.ptr((it+1)*k, j), 1);
+        bool conv = residuals();
+        if (verbose)
+          std::cout << "BlockGMRES it. " << totit << "\tres = "
+                    << std::setw(12) << res
+                    << "\trel.res = " << std::setw(12)
+                    << rel_res << std::endl;
+        if (conv || (totit >= maxit)) {
+          no_conv = false;
+          nrit = it;
+          break;
+        }
+      }
+      const std::size_t m = (nrit+1)*k;
+      DenseMW_t R(m, m, H, 0, 0), Y(m, k, G, 0, 0), Vm(n, m, V, 0, 0);
+      trsm(Side::L, UpLo::U, Trans::N, Diag::N, scalar_t(1.), R, Y);
+      gemm(Trans::N, Trans::N, scalar_t(1.), Vm, Y, scalar_t(1.), x);
+    }
+    return res;
+  }
+
 } // end namespace strumpack
 
 #endif // GMRES_HPP
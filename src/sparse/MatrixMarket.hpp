@@ -0,0 +1,271 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*!
+ * \file MatrixMarket.hpp
+ * \brief Contains routines to parse (parts of) a matrix in the
+ * Matrix Market coordinate format from a memory buffer.
+ */
+#ifndef STRUMPACK_MATRIX_MARKET_HPP
+#define STRUMPACK_MATRIX_MARKET_HPP
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <complex>
+#include <algorithm>
+#include "dense/BLASLAPACKWrapper.hpp"
+
+namespace strumpack {
+
+  template<typename scalar_t> scalar_t get_scalar(double vr, double vi) {
+    return scalar_t(vr);
+  }
+  template<> inline std::complex<double> get_scalar(double vr, double vi) {
+    return std::complex<double>(vr, vi);
+  }
+  template<> inline std::complex<float> get_scalar(double vr, double vi) {
+    return std::complex<float>(vr, vi);
+  }
+
+  /**
+   * Parsing of Matrix Market files. All routines work on a buffer
+   * [begin, end), typically a MappedFile, and do not require the
+   * buffer to be null terminated. Indices are returned as 64 bit
+   * integers, exactly as they appear in the file (so usually 1
+   * based).
+   */
+  namespace mm {
+
+    enum class Symmetry { GENERAL, SYMMETRIC, SKEWSYMMETRIC, HERMITIAN };
+
+    /**
+     * Information from the banner and the size line of a Matrix
+     * Market file.
+     */
+    struct Header {
+      Symmetry sym = Symmetry::GENERAL;
+      bool complex = false;
+      long long m = 0, n = 0, nnz = 0;
+      /** offset of the first entry, after the size line */
+      std::size_t data_begin = 0;
+      /** nonzeros after expanding symmetric storage (upper bound) */
+      long long expanded_nnz() const {
+        return sym == Symmetry::GENERAL ? nnz : 2 * nnz;
+      }
+    };
+
+    /** Return a pointer to the start of the line after p. */
+    inline const char* next_line(const char* p, const char* end) {
+      auto nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+      return nl ? nl + 1 : end;
+    }
+
+    /**
+     * Return the start of the first line that starts at, or after,
+     * position p. This is used to split a buffer in chunks that can
+     * be parsed independently.
+     */
+    inline const char* line_begin
+    (const char* begin, const char* p, const char* end) {
+      if (p <= begin) return begin;
+      if (p >= end) return end;
+      return next_line(p - 1, end);
+    }
+
+    inline const char* skip_blanks(const char* p, const char* end) {
+      while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+      return p;
+    }
+
+    inline bool parse_integer
+    (const char*& p, const char* end, long long& v) {
+      p = skip_blanks(p, end);
+      bool neg = false;
+      if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+      if (p == end || *p < '0' || *p > '9') return false;
+      long long x = 0;
+      while (p < end && *p >= '0' && *p <= '9') x = 10 * x + (*p++ - '0');
+      v = neg ? -x : x;
+      return true;
+    }
+
+    inline bool parse_real(const char*& p, const char* end, double& v) {
+      p = skip_blanks(p, end);
+      // copy the token, since the buffer is not null terminated
+      char tok[64];
+      int k = 0;
+      while (p < end && k < 63 && *p != ' ' && *p != '\t' &&
+             *p != '\r' && *p != '\n')
+        tok[k++] = *p++;
+      if (!k) return false;
+      tok[k] = '\0';
+      char* e;
+      v = std::strtod(tok, &e);
+      return e == tok + k;
+    }
+
+    /**
+     * Parse the banner and the size line. Prints an error message
+     * and returns false if the file is not a Matrix Market
+     * coordinate matrix that can be read with scalar type scalar_t.
+     */
+    template<typename scalar_t> bool read_header
+    (const char* begin, const char* end, Header& h, bool verbose=true) {
+      auto p = next_line(begin, end);
+      std::string banner(begin, p);
+      if (verbose) std::cout << "# " << banner;
+      if (banner.compare(0, 14, "%%MatrixMarket") ||
+          banner.find("coordinate") == std::string::npos) {
+        std::cerr << "ERROR: not a Matrix Market coordinate file"
+                  << std::endl;
+        return false;
+      }
+      if (banner.find("pattern") != std::string::npos) {
+        std::cerr << "ERROR: This is not a matrix,"
+                  << " but just a sparsity pattern" << std::endl;
+        return false;
+      }
+      h.complex = banner.find("complex") != std::string::npos;
+      if (h.complex && !is_complex<scalar_t>()) {
+        std::cerr << "ERROR: Complex matrix" << std::endl;
+        return false;
+      }
+      if (banner.find("skew-symmetric") != std::string::npos)
+        h.sym = Symmetry::SKEWSYMMETRIC;
+      else if (banner.find("symmetric") != std::string::npos)
+        h.sym = Symmetry::SYMMETRIC;
+      else if (banner.find("hermitian") != std::string::npos)
+        h.sym = Symmetry::HERMITIAN;
+      // skip comments and empty lines, the first line should be: m n nnz
+      while (p < end) {
+        auto q = skip_blanks(p, end);
+        if (q < end && *q != '%' && *q != '\n') break;
+        p = next_line(p, end);
+      }
+      if (!parse_integer(p, end, h.m) || !parse_integer(p, end, h.n) ||
+          !parse_integer(p, end, h.nnz) ||
+          h.m < 0 || h.n < 0 || h.nnz < 0) {
+        std::cerr << "ERROR: could not read the matrix size" << std::endl;
+        return false;
+      }
+      h.data_begin = next_line(p, end) - begin;
+      return true;
+    }
+
+    /**
+     * Return the value of the mirrored entry (c,r) for an entry (r,c)
+     * with value v, for symmetric storage.
+     */
+    template<typename scalar_t> scalar_t
+    mirror(Symmetry s, const scalar_t& v) {
+      switch (s) {
+      case Symmetry::SKEWSYMMETRIC: return -v;
+      case Symmetry::HERMITIAN: return blas::my_conj(v);
+      default: return v;
+      }
+    }
+
+    /**
+     * Parse all entries in the lines in [begin, end), and call
+     * f(r, c, v) for each of them. The row and column indices r and
+     * c are long long, as they appear in the file. Comment and empty
+     * lines are skipped. Returns false if a line could not be
+     * parsed, or if f returns false.
+     */
+    template<typename scalar_t,typename F> bool for_each_entry
+    (const char* begin, const char* end, bool complex, F f) {
+      auto p = begin;
+      while (p < end) {
+        p = skip_blanks(p, end);
+        if (p == end) break;
+        if (*p == '\n') { p++; continue; }
+        if (*p == '%') { p = next_line(p, end); continue; }
+        long long r, c;
+        double vr = 0., vi = 0.;
+        if (!parse_integer(p, end, r) || !parse_integer(p, end, c) ||
+            !parse_real(p, end, vr) || (complex && !parse_real(p, end, vi)))
+          return false;
+        if (!f(r, c, get_scalar<scalar_t>(vr, vi))) return false;
+        p = next_line(p, end);
+      }
+      return true;
+    }
+
+    /**
+     * Number of chunks (of roughly 4MB) to split a buffer of the
+     * given size in, for parsing with multiple threads.
+     */
+    inline long long chunks(std::size_t bytes) {
+      return std::max<long long>(1, bytes >> 22);
+    }
+
+    /**
+     * Parse the entries in [begin, end) with multiple threads. The
+     * buffer is split in chunks(end-begin) chunks, at line
+     * boundaries, and f(k, r, c, v) is called for each entry, with k
+     * the chunk, and for symmetric storage also for the mirrored
+     * entry (c, r). Calls to f with the same k are from the same
+     * thread. The minimum and maximum index are returned in imin
+     * and imax, which should be initialized by the caller. Returns
+     * false if a line could not be parsed, or if an index is not in
+     * [0, h.n].
+     */
+    template<typename scalar_t,typename F> bool for_each_entry_parallel
+    (const char* begin, const char* end, const Header& h,
+     long long& imin, long long& imax, F f) {
+      const auto len = end - begin;
+      const auto nc = chunks(len);
+      const bool symm = h.sym != Symmetry::GENERAL;
+      long long mn = imin, mx = imax;
+      bool ok = true;
+#pragma omp parallel for schedule(dynamic) reduction(min:mn) \
+  reduction(max:mx) reduction(&&:ok)
+      for (long long k=0; k<nc; k++)
+        ok = ok && for_each_entry<scalar_t>
+          (line_begin(begin, begin + k * len / nc, end),
+           line_begin(begin, begin + (k+1) * len / nc, end), h.complex,
+           [&](long long r, long long c, scalar_t v) {
+            if (r < 0 || c < 0 || r > h.n || c > h.n) return false;
+            mn = std::min(mn, std::min(r, c));
+            mx = std::max(mx, std::max(r, c));
+            f(k, r, c, v);
+            if (symm && r != c) f(k, c, r, mirror(h.sym, v));
+            return true;
+          });
+      imin = mn;
+      imax = mx;
+      return ok;
+    }
+
+  } // end namespace mm
+
+} // end namespace strumpack
+
+#endif // STRUMPACK_MATRIX_MARKET_HPP
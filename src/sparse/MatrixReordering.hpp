@@ -81,6 +81,8 @@ namespace strumpack {
 
     const std::vector<integer_t>& perm() const { return perm_; }
     const std::vector<integer_t>& iperm() const { return iperm_; }
+    std::vector<integer_t>& perm() { return perm_; }
+    std::vector<integer_t>& iperm() { return iperm_; }
 
     const SeparatorTree<integer_t>& tree() const { return *sep_tree_; }
     SeparatorTree<integer_t>& tree() { return *sep_tree_; }
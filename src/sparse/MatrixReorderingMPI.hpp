@@ -176,8 +176,8 @@ namespace strumpack {
     if (!is_parallel(opts.reordering_method())) {
       auto rank = comm_->rank();
       auto P = comm_->size();
-      // TODO only gather the graph? without the values or the diagonal
-      auto Aseq = A.gather();
+      // only the sparsity pattern, without the diagonal, is gathered
+      auto Aseq = A.gather_graph();
       std::unique_ptr<SeparatorTree<integer_t>> global_sep_tree;
       if (Aseq) { // only root
         switch (opts.reordering_method()) {
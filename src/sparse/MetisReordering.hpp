@@ -32,8 +32,10 @@
 #include <functional>
 #include <typeinfo>
 #include <memory>
+#include <cmath>
 #include <metis.h>
 #include "SeparatorTree.hpp"
+#include "StrumpackParameters.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "mumps_symqamd.hpp"
 #endif
@@ -106,6 +108,92 @@ namespace strumpack {
        NULL, NULL, NULL, &edge_cut, partitioning.data());
   }
 
+  /**
+   * Nested dissection of the graph (xadj, adjncy), without
+   * diagonal. The top levels are computed with
+   * METIS_ComputeVertexSeparator, and the two parts are ordered
+   * recursively, each in a separate OpenMP task. The separator is
+   * ordered last. Graphs with fewer than min_size vertices, or at
+   * the last level, are ordered with METIS_NodeND. Vertex v is
+   * ordered at position iperm[gid[v]], with gid the identity if it
+   * is empty. This should be called from a single thread in an
+   * OpenMP parallel region.
+   */
+  inline int metis_nested_dissection_rec
+  (std::vector<idx_t>& xadj, std::vector<idx_t>& adjncy,
+   const std::vector<idx_t>& gid, idx_t offset, int levels,
+   idx_t min_size, std::vector<idx_t>& iperm) {
+    idx_t n = xadj.size() - 1;
+    if (n == 0) return METIS_OK;
+    auto g = [&](idx_t v) { return gid.empty() ? v : gid[v]; };
+    int ierr;
+    std::vector<idx_t> part(n);
+    if (levels > 0 && n >= min_size) {
+      idx_t sepsize;
+      ierr = METIS_ComputeVertexSeparator
+        (&n, xadj.data(), adjncy.data(), NULL, NULL, &sepsize, part.data());
+      if (ierr != METIS_OK) return ierr;
+    }
+    // part is 0 for the first part, 1 for the second part and 2 for
+    // the separator, lid is the index of a vertex in its part
+    idx_t psize[3] = {0, 0, 0};
+    std::vector<idx_t> lid(n);
+    for (idx_t v=0; v<n; v++) lid[v] = psize[part[v]]++;
+    if (levels <= 0 || n < min_size || !psize[0] || !psize[1]) {
+      std::vector<idx_t> order(n), iorder(n);
+      ierr = METIS_NodeND
+        (&n, xadj.data(), adjncy.data(), NULL, NULL,
+         order.data(), iorder.data());
+      for (idx_t v=0; v<n; v++) iperm[g(v)] = offset + iorder[v];
+      return ierr;
+    }
+    for (idx_t v=0; v<n; v++)
+      if (part[v] == 2) iperm[g(v)] = offset + psize[0] + psize[1] + lid[v];
+    auto order_part = [&](int p) -> int {
+      std::vector<idx_t> pxadj(psize[p]+1), padjncy, pgid(psize[p]);
+      pxadj[0] = 0;
+      for (idx_t v=0; v<n; v++) {
+        if (part[v] != p) continue;
+        pgid[lid[v]] = g(v);
+        for (idx_t e=xadj[v]; e<xadj[v+1]; e++)
+          if (part[adjncy[e]] == p) padjncy.push_back(lid[adjncy[e]]);
+        pxadj[lid[v]+1] = padjncy.size();
+      }
+      return metis_nested_dissection_rec
+        (pxadj, padjncy, pgid, offset + (p ? psize[0] : 0),
+         levels-1, min_size, iperm);
+    };
+    int ierr0 = METIS_OK, ierr1 = METIS_OK;
+#pragma omp task default(shared)
+    ierr0 = order_part(0);
+#pragma omp task default(shared)
+    ierr1 = order_part(1);
+#pragma omp taskwait
+    return (ierr0 != METIS_OK) ? ierr0 : ierr1;
+  }
+
+  /**
+   * Same as WRAPPER_METIS_NodeND, but the top levels of the nested
+   * dissection are computed with multiple threads, see
+   * metis_nested_dissection_rec.
+   */
+  template<typename integer_t> inline int WRAPPER_METIS_NodeND_parallel
+  (std::vector<idx_t>& xadj, std::vector<idx_t>& adjncy,
+   std::vector<integer_t>& perm, std::vector<integer_t>& iperm) {
+    idx_t n = perm.size();
+    // at least two leaf subgraphs per thread, for load balance
+    int levels = std::ceil(std::log2(params::num_threads)) + 1;
+    std::vector<idx_t> order(n), iorder(n);
+    int ierr;
+#pragma omp parallel
+#pragma omp single
+    ierr = metis_nested_dissection_rec
+      (xadj, adjncy, std::vector<idx_t>(), 0, levels, 5000, iorder);
+    for (idx_t v=0; v<n; v++) order[iorder[v]] = v;
+    perm.assign(order.begin(), order.end());
+    iperm.assign(iorder.begin(), iorder.end());
+    return ierr;
+  }
 
   template<typename integer_t> std::unique_ptr<SeparatorTree<integer_t>>
   sep_tree_from_metis_sizes
@@ -185,11 +273,12 @@ namespace strumpack {
   }
 
   // TODO throw an exception
-  template<typename scalar_t,typename integer_t>
+  // A is a CompressedSparseMatrix or a CSRGraph, with or without the
+  // diagonal, only the sparsity pattern is used
+  template<typename scalar_t,typename integer_t,typename G>
   std::unique_ptr<SeparatorTree<integer_t>>
   metis_nested_dissection
-  (const CompressedSparseMatrix<scalar_t,integer_t>& A,
-   std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
+  (const G& A, std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
    const SPOptions<scalar_t>& opts) {
     auto n = A.size();
     auto ptr = A.ptr();
@@ -223,7 +312,10 @@ namespace strumpack {
       sep_tree = sep_tree_from_metis_sizes(nodes, separators, sizes);
 #endif
     } else {
-      ierr = WRAPPER_METIS_NodeND(xadj, adjncy, NULL, NULL, iperm, perm);
+      if (opts.use_parallel_ND() && params::num_threads > 1)
+        ierr = WRAPPER_METIS_NodeND_parallel(xadj, adjncy, iperm, perm);
+      else
+        ierr = WRAPPER_METIS_NodeND(xadj, adjncy, NULL, NULL, iperm, perm);
 #if defined(STRUMPACK_USE_MPI)
       if (opts.use_MUMPS_SYMQAMD())
         sep_tree = aggressive_amalgamation(A, perm, iperm, opts);
@@ -588,6 +588,7 @@ namespace strumpack {
         }
       }
     }
+    if (!F12.cols()) return; // F12 not stored (Cholesky)
     for (integer_t i=0; i<dim_upd; ++i) { // update columns
       //while (c < local_cols_ && global_col_[c] < upd[i]) c++;
       c = find_global(upd[i], c);
@@ -59,10 +59,11 @@ namespace strumpack {
     for (int i=0; i<n; i++) perm[i]--;
   }
 
-  template<typename scalar_t,typename integer_t>
+  // A is a CompressedSparseMatrix or a CSRGraph, with or without the
+  // diagonal, only the sparsity pattern is used
+  template<typename integer_t,typename G>
   std::unique_ptr<SeparatorTree<integer_t>> rcm_reordering
-  (const CompressedSparseMatrix<scalar_t,integer_t>& A,
-   std::vector<integer_t>& perm, std::vector<integer_t>& iperm) {
+  (const G& A, std::vector<integer_t>& perm, std::vector<integer_t>& iperm) {
     auto n = A.size();
     auto ptr = A.ptr();
     auto ind = A.ind();
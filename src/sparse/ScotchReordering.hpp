@@ -155,11 +155,12 @@ namespace strumpack {
   }
 
   // TODO throw exception on error
-  template<typename scalar_t,typename integer_t>
+  // A is a CompressedSparseMatrix or a CSRGraph, with or without the
+  // diagonal, only the sparsity pattern is used
+  template<typename scalar_t,typename integer_t,typename G>
   std::unique_ptr<SeparatorTree<integer_t>>
   scotch_nested_dissection
-  (const CompressedSparseMatrix<scalar_t,integer_t>& A,
-   std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
+  (const G& A, std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
    const SPOptions<scalar_t>& opts) {
     auto n = A.size();
     auto ptr = A.ptr();
@@ -43,15 +43,21 @@ extern "C" void MUMPS_SYMQAMD_FC
 
 namespace strumpack {
 
-  template<typename scalar_t,typename integer_t>
+  /**
+   * A can be a CompressedSparseMatrix or a CSRGraph, only its
+   * sparsity pattern is used, the diagonal is optional.
+   */
+  template<typename scalar_t,typename integer_t,typename G>
   std::unique_ptr<SeparatorTree<integer_t>> aggressive_amalgamation
-  (const CompressedSparseMatrix<scalar_t,integer_t>& A,
-   std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
+  (const G& A, std::vector<integer_t>& perm, std::vector<integer_t>& iperm,
    const SPOptions<scalar_t>& opts) {
     auto ptr = A.ptr();
     auto ind = A.ind();
     int N = A.size();
-    int NNZ = A.nnz();
+    int NNZ = N;                /* off-diagonal nonzeros + N */
+    for (int r=0; r<N; r++)
+      for (int j=ptr[r]; j<ptr[r+1]; j++)
+        if (ind[j] != r) NNZ++;
 
     int TRESH = 0;              /* <= 0 Recommended value. Automatic setting will be done. */
     int* NDENSE = new int[N];   /* [N] used internally */
@@ -88,11 +94,11 @@ namespace strumpack {
 
     for (int r=0; r<N; r++) {
       PERM[r] = perm[r] + 1;           /* permutation from integer_t to int, from C to Fortran */
-      LEN[r] = ptr[r+1] - ptr[r] - 1;  /* nonzeros in rows r, excluding diagonal */
       PE[r] = PFREE + 1;               /* row pointer */
       for (int j=ptr[r]; j<ptr[r+1]; j++) {
         if (ind[j] != r) IW[PFREE++] = ind[j]+1;
       }
+      LEN[r] = PFREE + 1 - PE[r];      /* nonzeros in rows r, excluding diagonal */
     }
     PFREE++;
     MUMPS_SYMQAMD_FC
@@ -131,6 +131,8 @@ int main(int argc, char* argv[]) {
         << "or\n\tmpirun -n 4 ./testMMdoubleMPIDist b pde900.bin\n"
         << "Specify the matrix input file with 'm filename'"
         << " if the matrix is in matrix-market format,\n"
+        << "with 'd filename' to read a matrix-market file"
+        << " with all processes,\n"
         << "or with 'b filename' if the matrix is in binary." << endl;
     MPI_Abort(MPI_COMM_WORLD, 1);
   }
@@ -139,15 +141,39 @@ int main(int argc, char* argv[]) {
   MPI_Comm_create_errhandler(abort_MPI, &eh);
   MPI_Comm_set_errhandler(MPI_COMM_WORLD, eh);
 
-  bool binary_input = false;
+  bool binary_input = false, distributed_input = false;
   string format(argv[1]);
   if (format.compare("b") == 0) binary_input = true;
   else if (format.compare("m") == 0) binary_input = false;
-  else cerr << "Error format is eiter b (binary) or m (matrix market)."
-            << endl;
+  else if (format.compare("d") == 0) distributed_input = true;
+  else cerr << "Error format is eiter b (binary), m (matrix market)"
+            << " or d (matrix market, read by all processes)." << endl;
 
   string f(argv[2]);
 
+  if (distributed_input) {
+    // every process reads its part of the file, no matching
+    int ierr = 0;
+    {
+      CSRMatrixMPI<double,int> Adist;
+      if (Adist.read_matrix_market(f, MPI_COMM_WORLD) == 0)
+        ierr = test(argc, argv, &Adist);
+      else {
+        CSRMatrixMPI<complex<double>,int> Adist_c;
+        if (Adist_c.read_matrix_market(f, MPI_COMM_WORLD)) {
+          if (!rank) cerr << "Could not read matrix from file." << endl;
+          MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        ierr = test(argc, argv, &Adist_c);
+      }
+    }
+    MPI_Errhandler_free(&eh);
+    TimerList::Finalize();
+    scalapack::Cblacs_exit(1);
+    MPI_Finalize();
+    return ierr;
+  }
+
   CSRMatrix<double,int>* A = NULL;
   CSRMatrix<complex<double>,int>* A_c = NULL;
   bool is_complex = false;
@@ -27,6 +27,7 @@
  *
  */
 #include <iostream>
+#include <cstdio>
 using namespace std;
 
 #include "StrumpackSparseSolver.hpp"
@@ -39,6 +40,22 @@ using namespace strumpack;
 
 template<typename scalar_t,typename integer_t> int
 test(int argc, char* argv[], CSRMatrix<scalar_t,integer_t>& A) {
+  {
+    // write the matrix in binary format, and read it back in
+    string fname = "test_sparse_seq_matrix.bin";
+    A.print_binary(fname);
+    CSRMatrix<scalar_t,integer_t> B;
+    auto ierr = B.read_binary(fname);
+    remove(fname.c_str());
+    if (ierr || B.size() != A.size() || B.nnz() != A.nnz() ||
+        !equal(A.ptr(), A.ptr()+A.size()+1, B.ptr()) ||
+        !equal(A.ind(), A.ind()+A.nnz(), B.ind()) ||
+        !equal(A.val(), A.val()+A.nnz(), B.val())) {
+      cout << "problem with binary matrix input/output." << endl;
+      return 1;
+    }
+  }
+
   StrumpackSparseSolver<scalar_t,integer_t> spss;
   spss.options().set_from_command_line(argc, argv);
 
@@ -57,6 +74,13 @@ test(int argc, char* argv[], CSRMatrix<scalar_t,integer_t>& A) {
     cout << "problem during factorization of the matrix." << endl;
     return 1;
   }
+  // the factors are part of the peak, so the predicted peak cannot
+  // be smaller
+  if (spss.peak_memory_estimate() < spss.factor_memory()) {
+    cout << "peak memory estimate is smaller than the factor memory."
+         << endl;
+    return 1;
+  }
   spss.solve(b.data(), x.data());
 
   auto comp_scal_res = A.max_scaled_residual(x.data(), b.data());
@@ -69,7 +93,62 @@ test(int argc, char* argv[], CSRMatrix<scalar_t,integer_t>& A) {
   cout << "# RELATIVE ERROR = " << (nrm_error/nrm_x_exact) << endl;
 
   if (comp_scal_res > ERROR_TOLERANCE*spss.options().rel_tol()) return 1;
-  else return 0;
+
+  // solve for multiple right hand sides at once
+  int nrhs = 4;
+  DenseMatrix<scalar_t> B(N, nrhs), X(N, nrhs), X_exact(N, nrhs);
+  X_exact.random();
+  A.spmv(X_exact, B);
+  spss.solve(B, X);
+  comp_scal_res = A.max_scaled_residual(X, B);
+  cout << "# COMPONENTWISE SCALED RESIDUAL (" << nrhs << " rhs) = "
+       << comp_scal_res << endl;
+  if (comp_scal_res > ERROR_TOLERANCE*spss.options().rel_tol()) return 1;
+
+  // change the values, keep the sparsity pattern, and refactor,
+  // reusing the reordering and symbolic factorization
+  CSRMatrix<scalar_t,integer_t> A2(A);
+  for (integer_t i=0; i<A2.size(); i++)
+    for (integer_t j=A2.ptr(i); j<A2.ptr(i+1); j++)
+      A2.val(j) *= (A2.ind(j) == i) ? scalar_t(2.) : scalar_t(.5);
+  A2.spmv(x_exact.data(), b.data());
+  spss.update_matrix_values(A2);
+  if (spss.factor() != ReturnCode::SUCCESS) {
+    cout << "problem during refactorization of the matrix." << endl;
+    return 1;
+  }
+  spss.solve(b.data(), x.data());
+  comp_scal_res = A2.max_scaled_residual(x.data(), b.data());
+  cout << "# COMPONENTWISE SCALED RESIDUAL (refactored) = "
+       << comp_scal_res << endl;
+  if (comp_scal_res > ERROR_TOLERANCE*spss.options().rel_tol()) return 1;
+
+  // write the factors to file, and read them back in a new solver
+  // (not supported with compression or mixed precision)
+  if (spss.options().compression() == CompressionType::NONE &&
+      !spss.options().use_mixed_precision()) {
+    string fname = "test_sparse_seq_factors.bin";
+    if (spss.save_factors(fname) != ReturnCode::SUCCESS) {
+      cout << "problem writing the factors to file." << endl;
+      return 1;
+    }
+    StrumpackSparseSolver<scalar_t,integer_t> spss2;
+    spss2.options().set_from_command_line(argc, argv);
+    spss2.set_matrix(A2);
+    auto ierr = spss2.load_factors(fname);
+    remove(fname.c_str());
+    if (ierr != ReturnCode::SUCCESS) {
+      cout << "problem reading the factors from file." << endl;
+      return 1;
+    }
+    std::fill(x.begin(), x.end(), scalar_t(0.));
+    spss2.solve(b.data(), x.data());
+    comp_scal_res = A2.max_scaled_residual(x.data(), b.data());
+    cout << "# COMPONENTWISE SCALED RESIDUAL (loaded factors) = "
+         << comp_scal_res << endl;
+    if (comp_scal_res > ERROR_TOLERANCE*spss.options().rel_tol()) return 1;
+  }
+  return 0;
 }
 
 int main(int argc, char* argv[]) {